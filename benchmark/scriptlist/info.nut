@@ -0,0 +1,13 @@
+class ScriptListBenchmark extends AIInfo {
+	function GetAuthor()      { return "OpenTTD NoAI Developers Team"; }
+	function GetName()        { return "ScriptListBenchmark"; }
+	function GetShortName()   { return "BSLI"; }
+	function GetDescription() { return "This runs the same workload on large AIList based lists every tick, to measure their performance."; }
+	function GetVersion()     { return 1; }
+	function GetAPIVersion()  { return "15"; }
+	function GetDate()        { return "2025-01-01"; }
+	function CreateInstance() { return "ScriptListBenchmark"; }
+	function UseAsRandomAI()  { return false; }
+}
+
+RegisterAI(ScriptListBenchmark());
@@ -0,0 +1,67 @@
+/*
+ * Benchmark of the AIList operations scripts use most on large lists.
+ *
+ * Copy this directory to the ai directory and start a game on a 256x256
+ * map with this AI as only company. The time the AI takes is shown in the
+ * framerate window (or with the 'fps' console command). Every round is
+ * logged with the number of tiles handled, and a checksum that must not
+ * change when the implementation of the lists changes.
+ */
+
+class ScriptListBenchmark extends AIController {
+	function Start();
+};
+
+function ScriptListBenchmark::Round(round)
+{
+	local list = AITileList();
+	list.AddRectangle(AIMap.GetTileIndex(1, 1), AIMap.GetTileIndex(AIMap.GetMapSizeX() - 2, AIMap.GetMapSizeY() - 2));
+	local count = list.Count();
+
+	/* Valuate and filter, the way AIs look for building sites. */
+	list.Valuate(AITile.GetMaxHeight);
+	list.KeepAboveValue(0);
+	list.Valuate(AIMap.DistanceManhattan, AIMap.GetTileIndex(AIMap.GetMapSizeX() / 2, AIMap.GetMapSizeY() / 2));
+	list.Sort(AIList.SORT_BY_VALUE, AIList.SORT_ASCENDING);
+
+	/* Walk the list and take a subset. */
+	local sum = 0;
+	foreach (tile, distance in list) sum += distance;
+	list.KeepTop(count / 2);
+
+	/* Combine lists. */
+	local other = AITileList();
+	other.AddRectangle(AIMap.GetTileIndex(1, 1), AIMap.GetTileIndex(AIMap.GetMapSizeX() / 2, AIMap.GetMapSizeY() / 2));
+	other.KeepList(list);
+	list.RemoveList(other);
+	list.AddList(other);
+	list.RemoveRectangle(AIMap.GetTileIndex(1, 1), AIMap.GetTileIndex(AIMap.GetMapSizeX() / 4, AIMap.GetMapSizeY() / 4));
+
+	/* Change and remove items while walking the list by value. */
+	foreach (tile, distance in list) {
+		if (distance % 3 == 0) {
+			list.RemoveItem(tile);
+		} else {
+			list.SetValue(tile, -distance);
+		}
+	}
+
+	/* Add items out of order, checking for items in between. */
+	local found = 0;
+	local added = AIList();
+	for (local i = 0; i < count; i++) {
+		added.AddItem((i * 7919) % count, i);
+		if (added.HasItem(i)) found++;
+	}
+	sum += found;
+
+	AILog.Info("Round " + round + ": " + count + " tiles, " + list.Count() + " left, checksum " + sum);
+}
+
+function ScriptListBenchmark::Start()
+{
+	for (local round = 1; true; round++) {
+		this.Round(round);
+		this.Sleep(1);
+	}
+}
@@ -15,6 +15,8 @@
 #include "../network/network.h"
 #include "../window_func.h"
 #include "../framerate_type.h"
+#include "../thread.h"
+#include "../script/script_thread.hpp"
 #include "ai_scanner.hpp"
 #include "ai_instance.hpp"
 #include "ai_config.hpp"
@@ -71,6 +73,22 @@
 	return;
 }
 
+/**
+ * Run the game loop of the AI of a company, and occasionally collect its garbage.
+ * @param c The company of the AI.
+ */
+static void RunAIGameLoop(const Company *c)
+{
+	PerformanceMeasurer framerate((PerformanceElement)(PFE_AI0 + c->index));
+	_current_company = c->index;
+	c->ai_instance->GameLoop();
+	/* Occasionally collect garbage; every 255 ticks do one company.
+	 * Effectively collecting garbage once every two months per AI. */
+	if ((AI::GetTick() & 255) == 0 && (CompanyID)GB(AI::GetTick(), 8, 4) == c->index) {
+		c->ai_instance->CollectGarbage();
+	}
+}
+
 /* static */ void AI::GameLoop()
 {
 	/* If we are in networking, only servers run this function, and that only if it is allowed */
@@ -82,20 +100,40 @@
 	if ((AI::frame_counter & ((1 << (4 - _settings_game.difficulty.competitor_speed)) - 1)) != 0) return;
 
 	Backup<CompanyID> cur_company(_current_company);
+	if (!_settings_game.ai.ai_parallel_execution) {
+		for (const Company *c : Company::Iterate()) {
+			if (c->is_ai) {
+				RunAIGameLoop(c);
+			} else {
+				PerformanceMeasurer::SetInactive((PerformanceElement)(PFE_AI0 + c->index));
+			}
+		}
+		cur_company.Restore();
+		return;
+	}
+
+	/* Run the AIs on worker threads. They only run their own bytecode in parallel;
+	 * the game state is accessed by one of them at a time, and is not changed as
+	 * their commands are queued. These are executed afterwards in company order,
+	 * so the outcome does not depend on how the threads were scheduled. */
+	std::vector<const Company *> companies;
 	for (const Company *c : Company::Iterate()) {
 		if (c->is_ai) {
-			PerformanceMeasurer framerate((PerformanceElement)(PFE_AI0 + c->index));
-			cur_company.Change(c->index);
-			c->ai_instance->GameLoop();
-			/* Occasionally collect garbage; every 255 ticks do one company.
-			 * Effectively collecting garbage once every two months per AI. */
-			if ((AI::frame_counter & 255) == 0 && (CompanyID)GB(AI::frame_counter, 8, 4) == c->index) {
-				c->ai_instance->CollectGarbage();
-			}
+			companies.push_back(c);
 		} else {
 			PerformanceMeasurer::SetInactive((PerformanceElement)(PFE_AI0 + c->index));
 		}
 	}
+
+	ParallelFor(0, static_cast<int>(companies.size()), [&companies](int i) {
+		ScriptWorkerScope worker;
+		RunAIGameLoop(companies[i]);
+	});
+
+	for (const Company *c : companies) {
+		cur_company.Change(c->index);
+		c->ai_instance->ExecuteQueuedCommands();
+	}
 	cur_company.Restore();
 }
 
@@ -205,9 +205,8 @@ bool StationCargoReroute::operator()(CargoPacket *cp)
 		this->destination->AddToCache(cp_new);
 	}
 
-	/* Legal, as insert doesn't invalidate iterators in the MultiMap, however
-	 * this might insert the packet between range.first and range.second (which might be end())
-	 * This is why we check for GetKey above to avoid infinite loops. */
+	/* Legal, as the packet is inserted into the range of a different next hop
+	 * than the one being shifted, which keeps the iterators of that range valid. */
 	this->destination->packets.Insert(next, cp_new);
 	return cp_new == cp;
 }
@@ -711,17 +711,22 @@ void StationCargoList::Append(CargoPacket *cp, StationID next)
 template <class Taction>
 bool StationCargoList::ShiftCargo(Taction &action, StationID next)
 {
-	std::pair<Iterator, Iterator> range(this->packets.equal_range(next));
-	for (Iterator it(range.first); it != range.second && it.GetKey() == next;) {
-		if (action.MaxMove() == 0) return false;
-		CargoPacket *cp = *it;
-		if (action(cp)) {
-			it = this->packets.erase(it);
-		} else {
-			return false;
-		}
+	StationCargoPacketMap::MapIterator range = this->packets.find(next);
+	if (range == this->packets.end()) return true;
+
+	/* Work on the range directly and drop all shifted packets in one go, instead
+	 * of erasing them one by one from the front of the vector. Inserting packets
+	 * for other next hops from within the action doesn't invalidate this range. */
+	StationCargoPacketMap::List &list = range->second;
+	StationCargoPacketMap::ListIterator it = list.begin();
+	while (it != list.end() && action.MaxMove() > 0 && action(*it)) ++it;
+
+	if (it == list.end()) {
+		this->packets.Map::erase(range);
+		return true;
 	}
-	return true;
+	list.erase(list.begin(), it);
+	return false;
 }
 
 /**
@@ -768,37 +773,49 @@ uint StationCargoList::Truncate(uint max_move, StationCargoAmountMap *cargo_per_
 	uint loop = 0;
 	bool do_count = cargo_per_source != nullptr;
 	while (max_move > moved) {
-		for (Iterator it(this->packets.begin()); it != this->packets.end();) {
-			CargoPacket *cp = *it;
-			if (prev_count > max_move && RandomRange(prev_count) < prev_count - max_move) {
-				if (do_count && loop == 0) {
-					(*cargo_per_source)[cp->first_station] += cp->count;
+		for (StationCargoPacketMap::MapIterator range = this->packets.begin(); range != this->packets.end();) {
+			/* Compact each range in place, so removing many packets stays linear. */
+			StationCargoPacketMap::List &list = range->second;
+			StationCargoPacketMap::ListIterator keep = list.begin();
+			bool done = false;
+			for (CargoPacket *cp : list) {
+				if (done || (prev_count > max_move && RandomRange(prev_count) < prev_count - max_move)) {
+					if (!done && do_count && loop == 0) {
+						(*cargo_per_source)[cp->first_station] += cp->count;
+					}
+					*keep++ = cp;
+					continue;
 				}
-				++it;
-				continue;
-			}
-			uint diff = max_move - moved;
-			if (cp->count > diff) {
-				if (diff > 0) {
-					this->RemoveFromCache(cp, diff);
-					cp->Reduce(diff);
-					moved += diff;
-				}
-				if (loop > 0) {
-					if (do_count) (*cargo_per_source)[cp->first_station] -= diff;
-					return moved;
+				uint diff = max_move - moved;
+				if (cp->count > diff) {
+					if (diff > 0) {
+						this->RemoveFromCache(cp, diff);
+						cp->Reduce(diff);
+						moved += diff;
+					}
+					if (loop > 0) {
+						if (do_count) (*cargo_per_source)[cp->first_station] -= diff;
+						done = true;
+					} else {
+						if (do_count) (*cargo_per_source)[cp->first_station] += cp->count;
+					}
+					*keep++ = cp;
 				} else {
-					if (do_count) (*cargo_per_source)[cp->first_station] += cp->count;
-					++it;
+					if (do_count && loop > 0) {
+						(*cargo_per_source)[cp->first_station] -= cp->count;
+					}
+					moved += cp->count;
+					this->RemoveFromCache(cp, cp->count);
+					delete cp;
 				}
+			}
+			list.erase(keep, list.end());
+
+			if (done) return moved;
+			if (list.empty()) {
+				range = this->packets.Map::erase(range);
 			} else {
-				it = this->packets.erase(it);
-				if (do_count && loop > 0) {
-					(*cargo_per_source)[cp->first_station] -= cp->count;
-				}
-				moved += cp->count;
-				this->RemoveFromCache(cp, cp->count);
-				delete cp;
+				++range;
 			}
 		}
 		loop++;
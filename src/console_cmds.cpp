@@ -25,7 +25,9 @@
 #include "fios.h"
 #include "fileio_func.h"
 #include "fontcache.h"
+#include "gfx_layout.h"
 #include "screenshot.h"
+#include "blitter/factory.hpp"
 #include "genworld.h"
 #include "strings_func.h"
 #include "viewport_func.h"
@@ -1714,6 +1716,7 @@ static bool ConScreenShot(std::span<std::string_view> argv)
 		IConsolePrint(CC_HELP, "  'no_con' hides the console to create the screenshot (only useful in combination with 'viewport').");
 		IConsolePrint(CC_HELP, "  'size' sets the width and height of the viewport to make a screenshot of (only useful in combination with 'normal' or 'big').");
 		IConsolePrint(CC_HELP, "  A filename ending in # will prevent overwriting existing files and will number files counting upwards.");
+		IConsolePrint(CC_HELP, "  Without graphics, e.g. on a dedicated server, only 'heightmap' and 'minimap' are available.");
 		return true;
 	}
 
@@ -1789,10 +1792,35 @@ static bool ConScreenShot(std::span<std::string_view> argv)
 		return false;
 	}
 
+	if (type != SC_HEIGHTMAP && type != SC_MINIMAP && BlitterFactory::GetCurrentBlitter()->GetScreenDepth() == 0) {
+		IConsolePrint(CC_ERROR, "This screenshot needs graphics; without them only 'heightmap' and 'minimap' are available.");
+		return true;
+	}
+
 	MakeScreenshot(type, std::move(name), width, height);
 	return true;
 }
 
+static bool ConExportTiles(std::span<std::string_view> argv)
+{
+	if (argv.empty()) {
+		IConsolePrint(CC_HELP, "Export the whole map as a pyramid of images for web map viewers. Usage: 'export_tiles [full]'.");
+		IConsolePrint(CC_HELP, "  The images are written to 'tiles/<level>/<x>/<y>' in the screenshot directory; level 0 is the most zoomed out.");
+		IConsolePrint(CC_HELP, "  Only images showing a part of the map that changed since the previous export are rendered again, unless 'full' is given.");
+		return true;
+	}
+
+	if (argv.size() > 2 || (argv.size() == 2 && argv[1] != "full")) return false;
+
+	if (BlitterFactory::GetCurrentBlitter()->GetScreenDepth() == 0) {
+		IConsolePrint(CC_ERROR, "Exporting the map needs graphics.");
+		return true;
+	}
+
+	MakeTiledWorldExport(argv.size() == 2);
+	return true;
+}
+
 static bool ConInfoCmd(std::span<std::string_view> argv)
 {
 	if (argv.empty()) {
@@ -2670,6 +2698,55 @@ static bool ConFramerate(std::span<std::string_view> argv)
 	return true;
 }
 
+static bool ConRedrawStatistics(std::span<std::string_view> argv)
+{
+	if (argv.empty()) {
+		IConsolePrint(CC_HELP, "Show the time spent and area painted per window class since the last reset. Usage: 'redraw_stats [on|off|reset]'.");
+		IConsolePrint(CC_HELP, "The statistics are only collected after 'redraw_stats on'. The most expensive window classes are shown first. The text line cache statistics are since the start.");
+		return true;
+	}
+
+	if (argv.size() > 2) return false;
+
+	if (argv.size() == 2) {
+		if (StrEqualsIgnoreCase(argv[1], "on")) {
+			EnableWindowRedrawStatistics(true);
+			IConsolePrint(CC_INFO, "Redraw statistics are being collected.");
+		} else if (StrEqualsIgnoreCase(argv[1], "off")) {
+			EnableWindowRedrawStatistics(false);
+			IConsolePrint(CC_INFO, "Redraw statistics are no longer collected.");
+		} else if (StrEqualsIgnoreCase(argv[1], "reset")) {
+			ResetWindowRedrawStatistics();
+			IConsolePrint(CC_INFO, "Redraw statistics reset.");
+		} else {
+			return false;
+		}
+		return true;
+	}
+
+	if (!AreWindowRedrawStatisticsEnabled()) IConsolePrint(CC_WARNING, "Redraw statistics are not being collected. Use 'redraw_stats on' to start.");
+
+	const WindowRedrawStatisticsArray &all_stats = GetWindowRedrawStatistics();
+	std::vector<WindowClass> classes;
+	for (WindowClass cls = WC_MAIN_WINDOW; cls != WC_END; cls = static_cast<WindowClass>(cls + 1)) {
+		const WindowRedrawStatistics &s = all_stats[cls];
+		if (s.paints != 0 || s.invalidations != 0 || s.coalesced != 0) classes.push_back(cls);
+	}
+	std::sort(classes.begin(), classes.end(), [&all_stats](WindowClass a, WindowClass b) { return all_stats[a].time > all_stats[b].time; });
+
+	for (WindowClass cls : classes) {
+		const WindowRedrawStatistics &s = all_stats[cls];
+		IConsolePrint(CC_DEFAULT, "{}: {} paints, {} pixels, {:.2f} ms painting, {} invalidations, {} coalesced",
+			GetWindowClassName(cls), s.paints, s.area, s.time / 1000.0, s.invalidations, s.coalesced);
+	}
+	if (classes.empty()) IConsolePrint(CC_INFO, "Nothing has been painted or invalidated since the last reset.");
+
+	Layouter::LineCacheStatistics lines = Layouter::GetLineCacheStatistics();
+	IConsolePrint(CC_DEFAULT, "Text line cache: {} of {} lines used, {} hits, {} misses, {} evictions, {} plain ASCII lines laid out",
+		lines.size, lines.capacity, lines.hits, lines.misses, lines.evictions, lines.fast_path);
+	return true;
+}
+
 static bool ConFramerateWindow(std::span<std::string_view> argv)
 {
 	if (argv.empty()) {
@@ -2890,6 +2967,7 @@ void IConsoleStdLibRegister()
 	IConsole::CmdRegister("reset_enginepool",        ConResetEnginePool,  ConHookNoNetwork);
 	IConsole::CmdRegister("return",                  ConReturn);
 	IConsole::CmdRegister("screenshot",              ConScreenShot);
+	IConsole::CmdRegister("export_tiles",            ConExportTiles);
 	IConsole::CmdRegister("script",                  ConScript);
 	IConsole::CmdRegister("zoomto",                  ConZoomToLevel);
 	IConsole::CmdRegister("scrollto",                ConScrollToTile);
@@ -3002,6 +3080,7 @@ void IConsoleStdLibRegister()
 #endif
 	IConsole::CmdRegister("fps",                     ConFramerate);
 	IConsole::CmdRegister("fps_wnd",                 ConFramerateWindow);
+	IConsole::CmdRegister("redraw_stats",            ConRedrawStatistics);
 
 	/* NewGRF development stuff */
 	IConsole::CmdRegister("reload_newgrfs",          ConNewGRFReload,     ConHookNewGRFDeveloperTool);
@@ -215,16 +215,19 @@ public:
 };
 
 /**
- * Hand-rolled multimap as map of lists. Behaves mostly like a list, but is sorted
+ * Hand-rolled multimap as map of vectors. Behaves mostly like a list, but is sorted
  * by Tkey so that you can easily look up ranges of equal keys. Those ranges are
  * internally ordered in a deterministic way (contrary to STL multimap). All
  * STL-compatible members are named in STL style, all others are named in OpenTTD
  * style.
+ * The ranges are stored contiguously, so erasing or inserting an item only keeps
+ * iterators into other ranges valid. Callers removing many items from the same
+ * range should operate on the range directly instead of using #erase repeatedly.
  */
 template <typename Tkey, typename Tvalue, typename Tcompare = std::less<Tkey> >
-class MultiMap : public std::map<Tkey, std::list<Tvalue>, Tcompare > {
+class MultiMap : public std::map<Tkey, std::vector<Tvalue>, Tcompare > {
 public:
-	typedef typename std::list<Tvalue> List;
+	typedef typename std::vector<Tvalue> List;
 	typedef typename List::iterator ListIterator;
 	typedef typename List::const_iterator ConstListIterator;
 
@@ -1545,8 +1545,12 @@ struct ReserveCargoAction {
 
 	bool operator()(Vehicle *v)
 	{
+		/* Don't walk the station's cargo list if there is nothing to reserve from. */
+		GoodsEntry &ge = st->goods[v->cargo_type];
+		if (!ge.HasData() || ge.GetData().cargo.AvailableCount() == 0) return true;
+
 		if (v->cargo_cap > v->cargo.RemainingCount() && MayLoadUnderExclusiveRights(st, v)) {
-			st->goods[v->cargo_type].GetOrCreateData().cargo.Reserve(v->cargo_cap - v->cargo.RemainingCount(),
+			ge.GetData().cargo.Reserve(v->cargo_cap - v->cargo.RemainingCount(),
 					&v->cargo, *next_station, v->GetCargoTile());
 		}
 
@@ -1618,11 +1622,17 @@ static void LoadUnloadVehicle(Vehicle *front)
 	StationID last_visited = front->last_station_visited;
 	Station *st = Station::Get(last_visited);
 
-	StationIDStack next_station = front->GetNextStoppingStation();
 	bool use_autorefit = front->current_order.IsRefit() && front->current_order.GetRefitCargo() == CARGO_AUTO_REFIT;
+	bool reserve = _settings_game.order.improved_load && use_autorefit ?
+			front->cargo_payment == nullptr : (front->current_order.GetLoadType() & OLFB_FULL_LOAD) != 0;
+
+	/* A consist that may not load yet is only visited to reserve cargo. Bail out
+	 * before looking at its orders if it won't do that either. */
+	if (front->load_unload_ticks != 0 && !reserve) return;
+
+	StationIDStack next_station = front->GetNextStoppingStation();
 	CargoArray consist_capleft{};
-	if (_settings_game.order.improved_load && use_autorefit ?
-			front->cargo_payment == nullptr : (front->current_order.GetLoadType() & OLFB_FULL_LOAD) != 0) {
+	if (reserve) {
 		ReserveConsist(st, front,
 				(use_autorefit && front->load_unload_ticks != 0) ? &consist_capleft : nullptr,
 				&next_station);
@@ -40,9 +40,38 @@ TrueTypeFontCache::~TrueTypeFontCache()
 void TrueTypeFontCache::ClearFontCache()
 {
 	this->glyph_to_sprite_map.clear();
+	this->glyph_allocator.Clear();
 	Layouter::ResetFontCache(this->fs);
 }
 
+/**
+ * Free all glyphs at once.
+ */
+void TrueTypeFontCache::GlyphAllocator::Clear()
+{
+	this->pages.clear();
+	this->page = nullptr;
+	this->page_used = PAGE_SIZE;
+}
+
+void *TrueTypeFontCache::GlyphAllocator::AllocatePtr(size_t size)
+{
+	/* Keep every sprite aligned like a separate allocation would be. */
+	size = Align(size, alignof(std::max_align_t));
+
+	/* Glyphs that would fill much of a page get their own. */
+	if (size > PAGE_SIZE / 4) return this->pages.emplace_back(std::make_unique<std::byte[]>(size)).get();
+
+	if (this->page_used + size > PAGE_SIZE) {
+		this->page = this->pages.emplace_back(std::make_unique<std::byte[]>(PAGE_SIZE)).get();
+		this->page_used = 0;
+	}
+
+	void *ptr = this->page + this->page_used;
+	this->page_used += size;
+	return ptr;
+}
+
 
 TrueTypeFontCache::GlyphEntry *TrueTypeFontCache::GetGlyphPtr(GlyphID key)
 {
@@ -67,7 +96,7 @@ uint TrueTypeFontCache::GetGlyphWidth(GlyphID key)
 	if ((key & SPRITE_GLYPH) != 0) return this->parent->GetGlyphWidth(key);
 
 	GlyphEntry *glyph = this->GetGlyphPtr(key);
-	if (glyph == nullptr || glyph->data == nullptr) {
+	if (glyph == nullptr || glyph->sprite == nullptr) {
 		this->GetGlyph(key);
 		glyph = this->GetGlyphPtr(key);
 	}
@@ -81,7 +110,7 @@ const Sprite *TrueTypeFontCache::GetGlyph(GlyphID key)
 
 	/* Check for the glyph in our cache */
 	GlyphEntry *glyph = this->GetGlyphPtr(key);
-	if (glyph != nullptr && glyph->data != nullptr) return glyph->GetSprite();
+	if (glyph != nullptr && glyph->sprite != nullptr) return glyph->GetSprite();
 
 	return this->InternalGetGlyph(key, GetFontAAState());
 }
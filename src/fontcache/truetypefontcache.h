@@ -11,6 +11,7 @@
 #define TRUETYPEFONTCACHE_H
 
 #include "../fontcache.h"
+#include "../spriteloader/spriteloader.hpp"
 
 
 static const int MAX_FONT_SIZE = 72; ///< Maximum font size.
@@ -27,15 +28,36 @@ protected:
 	int req_size = 0; ///< Requested font size.
 	int used_size = 0; ///< Used font size.
 
+	/**
+	 * Allocator of glyph sprites. Glyphs are packed into large pages instead of getting
+	 * an allocation each, so the glyphs of a font are close together in memory.
+	 * Glyphs are only freed all at once, when the font cache is cleared.
+	 */
+	class GlyphAllocator : public SpriteAllocator {
+	public:
+		void Clear();
+
+	protected:
+		void *AllocatePtr(size_t size) override;
+
+	private:
+		static constexpr size_t PAGE_SIZE = 64 * 1024; ///< Size of a page of glyphs.
+
+		std::vector<std::unique_ptr<std::byte[]>> pages; ///< Pages of glyphs, including glyphs too large to share a page.
+		std::byte *page = nullptr; ///< The page new glyphs are put in.
+		size_t page_used = PAGE_SIZE; ///< Number of bytes used of #page.
+	};
+
 	/** Container for information about a glyph. */
 	struct GlyphEntry {
-		std::unique_ptr<std::byte[]> data; ///< The loaded sprite.
+		Sprite *sprite = nullptr; ///< The loaded sprite, owned by the #GlyphAllocator.
 		uint8_t width = 0; ///< The width of the glyph.
 
-		Sprite *GetSprite() { return reinterpret_cast<Sprite *>(data.get()); }
+		Sprite *GetSprite() { return this->sprite; }
 	};
 
 	std::unordered_map<GlyphID, GlyphEntry> glyph_to_sprite_map{};
+	GlyphAllocator glyph_allocator; ///< Allocator of the glyph sprites.
 
 	GlyphEntry *GetGlyphPtr(GlyphID key);
 	GlyphEntry &SetGlyphPtr(GlyphID key, GlyphEntry &&glyph);
@@ -24,9 +24,11 @@
 #include "ai/ai_instance.hpp"
 #include "game/game.hpp"
 #include "game/game_instance.hpp"
+#include "script/squirrel.hpp"
 #include "timer/timer.h"
 #include "timer/timer_window.h"
 #include "zoom_func.h"
+#include "spritecache.h"
 
 #include "widgets/framerate_widget.h"
 
@@ -389,6 +391,8 @@ static constexpr NWidgetPart _framerate_window_widgets[] = {
 			NWidget(WWT_TEXT, INVALID_COLOUR, WID_FRW_RATE_GAMELOOP), SetToolTip(STR_FRAMERATE_RATE_GAMELOOP_TOOLTIP), SetFill(1, 0), SetResize(1, 0),
 			NWidget(WWT_TEXT, INVALID_COLOUR, WID_FRW_RATE_DRAWING),  SetToolTip(STR_FRAMERATE_RATE_BLITTER_TOOLTIP), SetFill(1, 0), SetResize(1, 0),
 			NWidget(WWT_TEXT, INVALID_COLOUR, WID_FRW_RATE_FACTOR), SetToolTip(STR_FRAMERATE_SPEED_FACTOR_TOOLTIP), SetFill(1, 0), SetResize(1, 0),
+			NWidget(WWT_TEXT, INVALID_COLOUR, WID_FRW_SPRITE_CACHE), SetToolTip(STR_FRAMERATE_SPRITE_CACHE_TOOLTIP), SetFill(1, 0), SetResize(1, 0),
+			NWidget(WWT_TEXT, INVALID_COLOUR, WID_FRW_SPRITE_CACHE_RATES), SetToolTip(STR_FRAMERATE_SPRITE_CACHE_RATES_TOOLTIP), SetFill(1, 0), SetResize(1, 0),
 		EndContainer(),
 	EndContainer(),
 	NWidget(NWID_HORIZONTAL),
@@ -444,6 +448,12 @@ struct FramerateWindow : Window {
 	std::array<CachedDecimal, PFE_MAX> times_shortterm{}; ///< cached short term average times
 	std::array<CachedDecimal, PFE_MAX> times_longterm{}; ///< cached long term average times
 
+	SpriteCacheStats sprite_cache{}; ///< cached sprite cache statistics
+	SpriteCacheStats sprite_cache_period = GetSpriteCacheStats(); ///< sprite cache statistics at the start of the current rate period
+	std::chrono::steady_clock::time_point sprite_cache_period_start = std::chrono::steady_clock::now(); ///< start of the current rate period
+	uint32_t sprite_cache_hit_rate = 10000; ///< cached percentage of sprite cache hits, with two decimals
+	uint64_t sprite_cache_evictions = 0; ///< cached number of sprite cache evictions per second
+
 	static constexpr int MIN_ELEMENTS = 5; ///< smallest number of elements to display
 
 	FramerateWindow(WindowDesc &desc, WindowNumber number) : Window(desc)
@@ -470,6 +480,7 @@ struct FramerateWindow : Window {
 		if (this->IsShaded()) return; // in small mode, this is everything needed
 
 		this->rate_drawing.SetRate(_pf_data[PFE_DRAWING].GetRate(), _settings_client.gui.refresh_rate);
+		this->UpdateSpriteCacheStats();
 
 		int new_active = 0;
 		for (PerformanceElement e = PFE_FIRST; e < PFE_MAX; e++) {
@@ -488,6 +499,23 @@ struct FramerateWindow : Window {
 		}
 	}
 
+	/** Update the sprite cache statistics; the rates are determined over periods of at least a second. */
+	void UpdateSpriteCacheStats()
+	{
+		this->sprite_cache = GetSpriteCacheStats();
+
+		auto now = std::chrono::steady_clock::now();
+		auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - this->sprite_cache_period_start).count();
+		if (elapsed < 1000) return;
+
+		uint64_t hits = this->sprite_cache.hits - this->sprite_cache_period.hits;
+		uint64_t requests = hits + this->sprite_cache.misses - this->sprite_cache_period.misses;
+		this->sprite_cache_hit_rate = (requests == 0) ? 10000 : static_cast<uint32_t>(hits * 10000 / requests);
+		this->sprite_cache_evictions = (this->sprite_cache.evictions - this->sprite_cache_period.evictions) * 1000 / elapsed;
+		this->sprite_cache_period = this->sprite_cache;
+		this->sprite_cache_period_start = now;
+	}
+
 	std::string GetWidgetString(WidgetID widget, StringID stringid) const override
 	{
 		switch (widget) {
@@ -506,6 +534,12 @@ struct FramerateWindow : Window {
 			case WID_FRW_RATE_FACTOR:
 				return GetString(STR_FRAMERATE_SPEED_FACTOR, this->speed_gameloop.GetValue(), this->speed_gameloop.GetDecimals());
 
+			case WID_FRW_SPRITE_CACHE:
+				return GetString(STR_FRAMERATE_SPRITE_CACHE, this->sprite_cache.bytes_used, this->sprite_cache.bytes_target);
+
+			case WID_FRW_SPRITE_CACHE_RATES:
+				return GetString(STR_FRAMERATE_SPRITE_CACHE_RATES, this->sprite_cache_hit_rate, 2, this->sprite_cache_evictions);
+
 			case WID_FRW_INFO_DATA_POINTS:
 				return GetString(STR_FRAMERATE_DATA_POINTS, NUM_FRAMERATE_POINTS);
 
@@ -526,6 +560,12 @@ struct FramerateWindow : Window {
 			case WID_FRW_RATE_FACTOR:
 				size = GetStringBoundingBox(GetString(STR_FRAMERATE_SPEED_FACTOR, GetParamMaxDigits(6), 2));
 				break;
+			case WID_FRW_SPRITE_CACHE:
+				size = GetStringBoundingBox(GetString(STR_FRAMERATE_SPRITE_CACHE, 1000ULL << 20, 1000ULL << 20));
+				break;
+			case WID_FRW_SPRITE_CACHE_RATES:
+				size = GetStringBoundingBox(GetString(STR_FRAMERATE_SPRITE_CACHE_RATES, 10000, 2, GetParamMaxDigits(6)));
+				break;
 
 			case WID_FRW_TIMES_NAMES: {
 				size.width = 0;
@@ -1052,6 +1092,26 @@ void ConPrintFramerate()
 		printed_anything = true;
 	}
 
+	for (PerformanceElement e = PFE_GAMESCRIPT; e < PFE_MAX; e++) {
+		if (_pf_data[e].num_valid == 0) continue;
+		const ScriptInstance *instance = e == PFE_GAMESCRIPT ? static_cast<const ScriptInstance *>(Game::GetInstance()) : Company::Get(e - PFE_AI0)->ai_instance.get();
+		if (instance == nullptr) continue;
+		std::optional<ScriptMemoryStatistics> stats = instance->GetMemoryStatistics();
+		if (!stats.has_value()) continue;
+
+		std::string_view name;
+		if (e < PFE_AI0) {
+			name = MEASUREMENT_NAMES[e];
+		} else {
+			ai_name_buf = fmt::format("AI {} {}", e - PFE_AI0 + 1, GetAIName(e - PFE_AI0));
+			name = ai_name_buf;
+		}
+		IConsolePrint(TC_LIGHT_BLUE, "{} memory: {} of {} KiB used, {} KiB allocated, {} KiB reserved for small objects",
+			name, stats->used / 1024, stats->limit / 1024, stats->allocated / 1024, stats->reserved / 1024);
+		IConsolePrint(TC_LIGHT_BLUE, "{} garbage: {} allocations, {} collections, {} objects freed in {}us by the last",
+			name, stats->allocations, stats->collections, stats->last_collected, stats->last_collection_time.count());
+	}
+
 	if (!printed_anything) {
 		IConsolePrint(CC_ERROR, "No performance measurements have been taken yet.");
 	}
@@ -22,6 +22,14 @@ enum LandscapeGenerator : uint8_t {
 	LG_TERRAGENESIS = 1,  ///< TerraGenesis Perlin landscape generator
 };
 
+/** River generators. */
+enum RiverGenerator : uint8_t {
+	/* Order of these enums has to be the same as in lang/english.txt
+	 * Otherwise you will get inconsistent behaviour. */
+	RG_ORIGINAL = 0, ///< Rivers flow from randomly found springs, routed by A*
+	RG_FLOW     = 1, ///< Rivers follow the flow of water over the whole map
+};
+
 static const uint32_t GENERATE_NEW_SEED = UINT32_MAX; ///< Create a new random seed
 
 /** Modes for GenerateWorld */
@@ -1319,6 +1319,16 @@ struct GenWorldStatus {
 	static inline StringID cls;
 	static inline uint current;
 	static inline uint total;
+	static inline std::chrono::steady_clock::time_point cls_start; ///< Moment the current class was started.
+
+	/**
+	 * Get the time spent in the current class so far.
+	 * @return The elapsed time.
+	 */
+	static std::chrono::milliseconds GetClassTime()
+	{
+		return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - GenWorldStatus::cls_start);
+	}
 };
 
 static const StringID _generation_class_table[]  = {
@@ -1384,7 +1394,8 @@ struct GenerateProgressWindow : public Window {
 				for (uint i = 0; i < GWP_CLASS_COUNT; i++) {
 					size.width = std::max(size.width, GetStringBoundingBox(_generation_class_table[i]).width + padding.width);
 				}
-				size.height = GetCharacterHeight(FS_NORMAL) * 2 + WidgetDimensions::scaled.vsep_normal;
+				size.width = std::max(size.width, GetStringBoundingBox(GetString(STR_GENERATION_PROGRESS_TIME, GetParamMaxDigits(4), GetParamMaxDigits(1))).width + padding.width);
+				size.height = GetCharacterHeight(FS_NORMAL) * 3 + WidgetDimensions::scaled.vsep_normal * 2;
 				break;
 		}
 	}
@@ -1409,6 +1420,11 @@ struct GenerateProgressWindow : public Window {
 				/* And say where we are in that class */
 				DrawString(r.left, r.right, r.top + GetCharacterHeight(FS_NORMAL) + WidgetDimensions::scaled.vsep_normal,
 					GetString(STR_GENERATION_PROGRESS_NUM, GenWorldStatus::current, GenWorldStatus::total), TC_FROMSTRING, SA_HOR_CENTER);
+
+				/* And how long we have been busy with it */
+				uint tenths = static_cast<uint>(GenWorldStatus::GetClassTime().count() / 100);
+				DrawString(r.left, r.right, r.top + (GetCharacterHeight(FS_NORMAL) + WidgetDimensions::scaled.vsep_normal) * 2,
+					GetString(STR_GENERATION_PROGRESS_TIME, tenths / 10, tenths % 10), TC_FROMSTRING, SA_HOR_CENTER);
 		}
 	}
 };
@@ -1422,6 +1438,7 @@ void PrepareGenerateWorldProgress()
 	GenWorldStatus::current = 0;
 	GenWorldStatus::total = 0;
 	GenWorldStatus::percent = 0;
+	GenWorldStatus::cls_start = std::chrono::steady_clock::now();
 }
 
 /**
@@ -1455,6 +1472,10 @@ static void _SetGeneratingWorldProgress(GenWorldProgress cls, uint progress, uin
 		GenWorldStatus::current += progress;
 		assert(GenWorldStatus::current <= GenWorldStatus::total);
 	} else {
+		if (GenWorldStatus::cls != _generation_class_table[cls]) {
+			Debug(map, 1, "World generation: {} took {} ms", StrMakeValid(GetString(GenWorldStatus::cls)), GenWorldStatus::GetClassTime().count());
+			GenWorldStatus::cls_start = std::chrono::steady_clock::now();
+		}
 		GenWorldStatus::cls     = _generation_class_table[cls];
 		GenWorldStatus::current = progress;
 		GenWorldStatus::total   = total;
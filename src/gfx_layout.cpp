@@ -37,6 +37,15 @@
 /** Cache of ParagraphLayout lines. */
 std::unique_ptr<Layouter::LineCache> Layouter::linecache;
 
+/** Number of lines the line cache holds initially. */
+static const size_t LINE_CACHE_INITIAL_SIZE = 4096;
+/** Number of lines the line cache may grow to when it thrashes. */
+static const size_t LINE_CACHE_MAX_SIZE = 32768;
+
+Layouter::LineCacheStatistics Layouter::linecache_stats; ///< Statistics of the line cache.
+uint64_t Layouter::linecache_window_lookups = 0; ///< Lookups in the line cache since it was last checked for thrashing.
+uint64_t Layouter::linecache_window_evictions = 0; ///< Evictions from the line cache since it was last checked for thrashing.
+
 /** Cache of Font instances. */
 Layouter::FontColourMap Layouter::fonts[FS_END];
 
@@ -120,6 +129,17 @@ static inline void GetLayouter(Layouter::LineCacheItem &line, std::string_view s
 	line.state_after = state;
 }
 
+/**
+ * Check whether a line consists of printable ASCII characters only. Such a line has
+ * a single run in one font and colour, and needs no shaping or bidirectional reordering.
+ * @param str The line.
+ * @return True if the line only contains printable ASCII characters.
+ */
+static bool IsPlainAsciiLine(std::string_view str)
+{
+	return std::all_of(str.begin(), str.end(), [](char c) { return c >= 0x20 && c < 0x7F; });
+}
+
 /**
  * Create a new layouter.
  * @param str      The string to create the layout for.
@@ -142,6 +162,13 @@ Layouter::Layouter(std::string_view str, int maxw, FontSize fontsize) : string(s
 			/* Line is new, layout it */
 			FontState old_state = state;
 
+			/* Plain ASCII in a left-to-right language does not need the shaping of the platform layouters,
+			 * which is expensive for some fonts. */
+			if (_current_text_dir == TD_LTR && IsPlainAsciiLine(str_line)) {
+				GetLayouter<FallbackParagraphLayoutFactory>(line, str_line, state);
+				linecache_stats.fast_path++;
+			}
+
 #if defined(WITH_ICU_I18N) && defined(WITH_HARFBUZZ)
 			if (line.layout == nullptr) {
 				GetLayouter<ICUParagraphLayoutFactory>(line, str_line, state);
@@ -390,14 +417,32 @@ Layouter::LineCacheItem &Layouter::GetCachedParagraphLayout(std::string_view str
 {
 	if (linecache == nullptr) {
 		/* Create linecache on first access to avoid trouble with initialisation order of static variables. */
-		linecache = std::make_unique<LineCache>(4096);
+		linecache = std::make_unique<LineCache>(LINE_CACHE_INITIAL_SIZE);
+	}
+
+	/* Every so many lookups, check whether the cache thrashes: when it evicted many lines,
+	 * the lines that are shown do not fit in the cache, so let it grow. */
+	if (++linecache_window_lookups >= linecache->GetCapacity()) {
+		if (linecache_window_evictions > linecache->GetCapacity() / 4 && linecache->GetCapacity() < LINE_CACHE_MAX_SIZE) {
+			linecache->SetCapacity(linecache->GetCapacity() * 2);
+			Debug(fontcache, 3, "Line cache thrashes, growing it to {} lines", linecache->GetCapacity());
+		}
+		linecache_window_lookups = 0;
+		linecache_window_evictions = 0;
 	}
 
 	if (auto match = linecache->GetIfValid(LineCacheQuery{state, str});
 		match != nullptr) {
+		linecache_stats.hits++;
 		return *match;
 	}
 
+	linecache_stats.misses++;
+	if (linecache->Size() >= linecache->GetCapacity()) {
+		linecache_stats.evictions++;
+		linecache_window_evictions++;
+	}
+
 	/* Create missing entry */
 	LineCacheKey key;
 	key.state_before = state;
@@ -414,6 +459,20 @@ void Layouter::ResetLineCache()
 	if (linecache != nullptr) linecache->Clear();
 }
 
+/**
+ * Get the statistics of the line cache since the game started.
+ * @return The statistics.
+ */
+Layouter::LineCacheStatistics Layouter::GetLineCacheStatistics()
+{
+	LineCacheStatistics stats = linecache_stats;
+	if (linecache != nullptr) {
+		stats.size = linecache->Size();
+		stats.capacity = linecache->GetCapacity();
+	}
+	return stats;
+}
+
 /**
  * Get the leading corner of a character in a single-line string relative
  * to the start of the string.
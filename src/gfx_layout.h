@@ -203,6 +203,21 @@ private:
 	using LineCache = LRUCache<LineCacheKey, LineCacheItem, LineCacheHash, LineCacheEqualTo>;
 	static std::unique_ptr<LineCache> linecache;
 
+public:
+	/** Statistics of the line cache. */
+	struct LineCacheStatistics {
+		uint64_t hits = 0; ///< Number of lines found in the cache.
+		uint64_t misses = 0; ///< Number of lines that had to be laid out.
+		uint64_t evictions = 0; ///< Number of lines removed to make room for other lines.
+		uint64_t fast_path = 0; ///< Number of lines laid out without the paragraph layouter of the platform.
+		size_t size = 0; ///< Number of lines in the cache.
+		size_t capacity = 0; ///< Number of lines the cache may hold now.
+	};
+private:
+	static LineCacheStatistics linecache_stats;
+	static uint64_t linecache_window_lookups;
+	static uint64_t linecache_window_evictions;
+
 	static LineCacheItem &GetCachedParagraphLayout(std::string_view str, const FontState &state);
 
 	using FontColourMap = std::map<TextColour, std::unique_ptr<Font>>;
@@ -218,6 +233,7 @@ public:
 	static void Initialize();
 	static void ResetFontCache(FontSize size);
 	static void ResetLineCache();
+	static LineCacheStatistics GetLineCacheStatistics();
 };
 
 ParagraphLayouter::Position GetCharPosInString(std::string_view str, size_t pos, FontSize start_fontsize = FS_NORMAL);
@@ -10,6 +10,7 @@
 /** @defgroup SnowLineGroup Snowline functions and data structures */
 
 #include "stdafx.h"
+#include <queue>
 #include "heightmap.h"
 #include "clear_map.h"
 #include "spritecache.h"
@@ -1378,13 +1379,188 @@ static std::tuple<bool, bool> FlowRiver(TileIndex spring, TileIndex begin, uint
 }
 
 /**
- * Actually (try to) create some rivers.
+ * Determine for every tile where its water flows to and how much water flows through it.
+ *
+ * This is a priority-flood: starting from the sea and the map borders, tiles are visited
+ * from low to high, so every tile is reached from a neighbour that already has a way
+ * down. Depressions are filled implicitly, as the water of a depression flows over the
+ * lowest tile of its rim. Then the rain is accumulated, in the reverse order of visiting,
+ * into the receivers of the tiles.
+ * @param[out] receivers For every tile the direction the water flows to, or INVALID_DIAGDIR when it leaves the map or flows into the sea.
+ * @param[out] flow For every tile the number of tiles whose rain flows through it.
  */
-static void CreateRivers()
+static void CalculateRiverFlow(std::vector<DiagDirection> &receivers, std::vector<uint32_t> &flow)
 {
-	int amount = _settings_game.game_creation.amount_of_rivers;
-	if (amount == 0) return;
+	/** State of a tile during the flood. */
+	enum FloodState : uint8_t {
+		FS_NONE,    ///< Not reached yet.
+		FS_QUEUED,  ///< Reached, but its receiver is not final yet.
+		FS_VISITED, ///< Visited; all tiles visited later may drain into it.
+	};
+
+	std::vector<FloodState> state(Map::Size(), FS_NONE);
+	receivers.assign(Map::Size(), INVALID_DIAGDIR);
+	flow.assign(Map::Size(), 0);
+
+	/* Ordered by height, then by the order tiles were queued; the latter keeps the result deterministic. */
+	using QueueItem = std::pair<uint64_t, TileIndex>;
+	std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<>> queue;
+	uint32_t sequence = 0;
+	auto enqueue = [&](TileIndex tile, uint height) {
+		state[tile.base()] = FS_QUEUED;
+		queue.emplace((static_cast<uint64_t>(height) << 32) | sequence++, tile);
+	};
+
+	for (const auto tile : Map::Iterate()) {
+		if (!IsValidTile(tile)) continue;
+
+		bool at_border = false;
+		for (DiagDirection d = DIAGDIR_BEGIN; d < DIAGDIR_END; d++) {
+			if (!IsValidTile(tile + TileOffsByDiagDir(d))) at_border = true;
+		}
+		if (at_border || IsWaterTile(tile)) enqueue(tile, GetTileZ(tile));
+	}
+
+	std::vector<TileIndex> visited;
+	visited.reserve(Map::Size());
+	while (!queue.empty()) {
+		auto [key, tile] = queue.top();
+		queue.pop();
+
+		/* Prefer a receiver the river can actually flow down to; otherwise keep the one the flood came from. */
+		if (receivers[tile.base()] != INVALID_DIAGDIR && !FlowsDown(tile, tile + TileOffsByDiagDir(receivers[tile.base()]))) {
+			for (DiagDirection d = DIAGDIR_BEGIN; d < DIAGDIR_END; d++) {
+				TileIndex t = tile + TileOffsByDiagDir(d);
+				if (IsValidTile(t) && state[t.base()] == FS_VISITED && FlowsDown(tile, t)) {
+					receivers[tile.base()] = d;
+					break;
+				}
+			}
+		}
+		state[tile.base()] = FS_VISITED;
+		visited.push_back(tile);
+
+		uint height = key >> 32;
+		for (DiagDirection d = DIAGDIR_BEGIN; d < DIAGDIR_END; d++) {
+			TileIndex t = tile + TileOffsByDiagDir(d);
+			if (!IsValidTile(t) || state[t.base()] != FS_NONE) continue;
+
+			receivers[t.base()] = ReverseDiagDir(d);
+			enqueue(t, std::max<uint>(GetTileZ(t), height));
+		}
+	}
+	IncreaseGeneratingWorldProgress(GWP_RIVER);
+
+	/* Every tile is visited after its receiver, so going backwards all water upstream of a tile has been gathered. */
+	for (auto it = visited.rbegin(); it != visited.rend(); ++it) {
+		TileIndex tile = *it;
+		if (IsWaterTile(tile)) continue;
+
+		/* It hardly rains in the desert. */
+		if (_settings_game.game_creation.landscape != LandscapeType::Tropic || GetTropicZone(tile) != TROPICZONE_DESERT) flow[tile.base()]++;
+		if (receivers[tile.base()] != INVALID_DIAGDIR) flow[(tile + TileOffsByDiagDir(receivers[tile.base()])).base()] += flow[tile.base()];
+	}
+	IncreaseGeneratingWorldProgress(GWP_RIVER);
+}
+
+/**
+ * Create rivers along the courses the water would take according to the flow over the whole map.
+ * A river starts where enough water has come together, and follows the flow down until it
+ * reaches the sea, another river or the border of the map. When it gets stuck in a valley,
+ * a lake is made instead.
+ */
+static void CreateFlowRivers()
+{
+	std::vector<DiagDirection> receivers;
+	std::vector<uint32_t> flow;
+	CalculateRiverFlow(receivers, flow);
+
+	const uint32_t min_flow = 1U << (11 - _settings_game.game_creation.amount_of_rivers);
+	const uint min_river_length = _settings_game.game_creation.min_river_length;
 
+	/* A river starts at a tile with enough water, when none of the tiles draining into it has enough water. */
+	std::vector<bool> has_river_upstream(Map::Size(), false);
+	for (const TileIndex tile : Map::Iterate()) {
+		if (flow[tile.base()] >= min_flow && receivers[tile.base()] != INVALID_DIAGDIR) has_river_upstream[(tile + TileOffsByDiagDir(receivers[tile.base()])).base()] = true;
+	}
+
+	std::vector<TileIndex> course;
+	for (const TileIndex spring : Map::Iterate()) {
+		if (flow[spring.base()] < min_flow || has_river_upstream[spring.base()] || IsWaterTile(spring)) continue;
+
+		/* Follow the water down until it can't flow any further. */
+		course.clear();
+		bool found = false;
+		TileIndex tile = spring;
+		for (;;) {
+			if (IsWaterTile(tile)) {
+				found = true;
+				break;
+			}
+
+			Slope slope = GetTileSlope(tile);
+			if (slope != SLOPE_FLAT && !IsInclinedSlope(slope)) {
+				/* Rivers can't be built here; start further down instead. */
+				if (course.empty() && receivers[tile.base()] != INVALID_DIAGDIR) {
+					tile += TileOffsByDiagDir(receivers[tile.base()]);
+					continue;
+				}
+				break;
+			}
+
+			course.push_back(tile);
+			if (receivers[tile.base()] == INVALID_DIAGDIR) {
+				/* The river flows off the map. */
+				found = true;
+				break;
+			}
+
+			TileIndex next = tile + TileOffsByDiagDir(receivers[tile.base()]);
+			if (!FlowsDown(tile, next)) {
+				/* Stuck in a valley; make a lake if the river is long enough to warrant one. */
+				if (course.size() > min_river_length && IsTileFlat(tile) &&
+						(_settings_game.game_creation.landscape != LandscapeType::Tropic || GetTropicZone(tile) != TROPICZONE_DESERT)) {
+					MakeRiverAndModifyDesertZoneAround(tile);
+					uint diameter = RandomRange(8) + 3;
+
+					/* Run the loop twice, so artefacts from going circular in one direction get (mostly) hidden. */
+					for (uint loops = 0; loops < 2; ++loops) {
+						for (auto t : SpiralTileSequence(tile, diameter)) {
+							MakeLake(t, TileHeight(tile));
+						}
+					}
+					found = true;
+				}
+				break;
+			}
+			tile = next;
+		}
+
+		if (!found || course.size() < min_river_length) continue;
+
+		for (TileIndex t : course) {
+			if (!IsWaterTile(t)) MakeRiverAndModifyDesertZoneAround(t);
+		}
+
+		/* Widen the river where much water flows through it. Don't make wide rivers if we're using the original landscape generator. */
+		if (_settings_game.game_creation.land_generator == LG_ORIGINAL) continue;
+		for (TileIndex origin_tile : course) {
+			uint diameter = flow[origin_tile.base()] >= min_flow * 16 ? 3 : (flow[origin_tile.base()] >= min_flow * 4 ? 2 : 1);
+			if (diameter <= 1) continue;
+
+			for (auto t : SpiralTileSequence(origin_tile, diameter)) {
+				RiverMakeWider(t, origin_tile);
+			}
+		}
+	}
+	IncreaseGeneratingWorldProgress(GWP_RIVER);
+}
+
+/**
+ * Create rivers starting at springs found around random tiles, and route them with A*.
+ */
+static void CreateOriginalRivers()
+{
 	uint wells = Map::ScaleBySize(4 << _settings_game.game_creation.amount_of_rivers);
 	const uint num_short_rivers = wells - std::max(1u, wells / 10);
 	SetGeneratingWorldProgress(GWP_RIVER, wells + TILE_UPDATE_FREQUENCY / 64); // Include the tile loop calls below.
@@ -1418,6 +1594,22 @@ static void CreateRivers()
 			if (done) break;
 		}
 	}
+}
+
+/**
+ * Actually (try to) create some rivers.
+ */
+static void CreateRivers()
+{
+	int amount = _settings_game.game_creation.amount_of_rivers;
+	if (amount == 0) return;
+
+	if (_settings_game.game_creation.river_generator == RG_FLOW) {
+		SetGeneratingWorldProgress(GWP_RIVER, 3 + TILE_UPDATE_FREQUENCY / 64); // Include the tile loop calls below.
+		CreateFlowRivers();
+	} else {
+		CreateOriginalRivers();
+	}
 
 	/* Widening rivers may have left some tiles requiring to be watered. */
 	ConvertGroundTilesIntoWaterTiles();
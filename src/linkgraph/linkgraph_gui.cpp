@@ -66,22 +66,23 @@ void LinkGraphOverlay::GetWidgetDpi(DrawPixelInfo *dpi) const
 }
 
 /**
- * Rebuild the cache and recalculate which links and stations to be shown.
+ * Rebuild the cache of all links and stations of the shown companies and cargoes.
+ * This does not depend on the shown part of the map, so scrolling does not need it.
  */
 void LinkGraphOverlay::RebuildCache()
 {
+	/* The visible links point into the cached links, so they go as well. */
+	this->visible_links.clear();
+	this->visible_stations.clear();
 	this->cached_links.clear();
 	this->cached_stations.clear();
+	this->dirty = false;
+	this->view_dirty = true;
 	if (this->company_mask.None()) return;
 
-	DrawPixelInfo dpi;
-	this->GetWidgetDpi(&dpi);
-
 	for (const Station *sta : Station::Iterate()) {
 		if (sta->rect.IsEmpty()) continue;
 
-		Point pta = this->GetStationMiddle(sta);
-
 		StationID from = sta->index;
 		StationLinkMap &seen_links = this->cached_links[from];
 
@@ -106,14 +107,44 @@ void LinkGraphOverlay::RebuildCache()
 				if (stb->owner != OWNER_NONE && sta->owner != OWNER_NONE && !this->company_mask.Test(stb->owner)) continue;
 				if (stb->rect.IsEmpty()) continue;
 
-				if (!this->IsLinkVisible(pta, this->GetStationMiddle(stb), &dpi)) continue;
-
 				this->AddLinks(sta, stb);
 				seen_links[to]; // make sure it is created and marked as seen
 			}
 		}
-		if (this->IsPointVisible(pta, &dpi)) {
-			this->cached_stations.emplace_back(from, supply);
+		this->cached_stations.emplace_back(from, supply);
+	}
+}
+
+/**
+ * Determine which of the cached links and stations are inside the window.
+ */
+void LinkGraphOverlay::RebuildVisible()
+{
+	this->visible_links.clear();
+	this->visible_stations.clear();
+	this->view_dirty = false;
+
+	DrawPixelInfo dpi;
+	this->GetWidgetDpi(&dpi);
+	this->visible_size = {static_cast<uint>(dpi.width), static_cast<uint>(dpi.height)};
+
+	/* Determine where each station is once, instead of for each of its links. */
+	std::vector<Point> middles(Station::GetPoolSize());
+	for (const auto &[station, supply] : this->cached_stations) {
+		const Station *st = Station::GetIfValid(station);
+		if (st == nullptr) continue;
+
+		middles[station.base()] = this->GetStationMiddle(st);
+		if (this->IsPointVisible(middles[station.base()], &dpi)) this->visible_stations.emplace_back(station, supply);
+	}
+
+	for (const auto &[from, links] : this->cached_links) {
+		if (!Station::IsValidID(from)) continue;
+		for (const auto &[to, properties] : links) {
+			if (!Station::IsValidID(to)) continue;
+			if (!this->IsLinkVisible(middles[from.base()], middles[to.base()], &dpi)) continue;
+
+			this->visible_links.emplace_back(from, to, &properties);
 		}
 	}
 }
@@ -255,16 +286,27 @@ void LinkGraphOverlay::AddLinks(const Station *from, const Station *to)
 	if (new_shared) cargo.shared = true;
 }
 
+/**
+ * Rebuild the cached links and stations and the visible ones, when they have been marked dirty.
+ */
+void LinkGraphOverlay::RebuildIfDirty()
+{
+	if (this->dirty) this->RebuildCache();
+
+	/* Resizing the window changes what is visible as well. */
+	const NWidgetBase *wi = this->window->GetWidget<NWidgetBase>(this->widget_id);
+	if (wi->current_x != this->visible_size.width || wi->current_y != this->visible_size.height) this->view_dirty = true;
+
+	if (this->view_dirty) this->RebuildVisible();
+}
+
 /**
  * Draw the linkgraph overlay or some part of it, in the area given.
  * @param dpi Area to be drawn to.
  */
 void LinkGraphOverlay::Draw(const DrawPixelInfo *dpi)
 {
-	if (this->dirty) {
-		this->RebuildCache();
-		this->dirty = false;
-	}
+	this->RebuildIfDirty();
 	this->DrawLinks(dpi);
 	this->DrawStationDots(dpi);
 }
@@ -276,15 +318,12 @@ void LinkGraphOverlay::Draw(const DrawPixelInfo *dpi)
 void LinkGraphOverlay::DrawLinks(const DrawPixelInfo *dpi) const
 {
 	int width = ScaleGUITrad(this->scale);
-	for (const auto &i : this->cached_links) {
-		if (!Station::IsValidID(i.first)) continue;
-		Point pta = this->GetStationMiddle(Station::Get(i.first));
-		for (const auto &j : i.second) {
-			if (!Station::IsValidID(j.first)) continue;
-			Point ptb = this->GetStationMiddle(Station::Get(j.first));
-			if (!this->IsLinkVisible(pta, ptb, dpi, width + 2)) continue;
-			this->DrawContent(pta, ptb, j.second);
-		}
+	for (const VisibleLink &link : this->visible_links) {
+		if (!Station::IsValidID(link.from) || !Station::IsValidID(link.to)) continue;
+		Point pta = this->GetStationMiddle(Station::Get(link.from));
+		Point ptb = this->GetStationMiddle(Station::Get(link.to));
+		if (!this->IsLinkVisible(pta, ptb, dpi, width + 2)) continue;
+		this->DrawContent(pta, ptb, *link.properties);
 	}
 }
 
@@ -322,7 +361,7 @@ void LinkGraphOverlay::DrawContent(Point pta, Point ptb, const LinkProperties &c
 void LinkGraphOverlay::DrawStationDots(const DrawPixelInfo *dpi) const
 {
 	int width = ScaleGUITrad(this->scale);
-	for (const auto &i : this->cached_stations) {
+	for (const auto &i : this->visible_stations) {
 		const Station *st = Station::GetIfValid(i.first);
 		if (st == nullptr) continue;
 		Point pt = this->GetStationMiddle(st);
@@ -358,48 +397,49 @@ void LinkGraphOverlay::DrawStationDots(const DrawPixelInfo *dpi) const
 
 bool LinkGraphOverlay::ShowTooltip(Point pt, TooltipCloseCondition close_cond)
 {
-	for (auto i(this->cached_links.crbegin()); i != this->cached_links.crend(); ++i) {
-		if (!Station::IsValidID(i->first)) continue;
-		Point pta = this->GetStationMiddle(Station::Get(i->first));
-		for (auto j(i->second.crbegin()); j != i->second.crend(); ++j) {
-			if (!Station::IsValidID(j->first)) continue;
-			if (i->first == j->first) continue;
-
-			/* Check the distance from the cursor to the line defined by the two stations. */
-			Point ptb = this->GetStationMiddle(Station::Get(j->first));
-			float dist = std::abs((int64_t)(ptb.x - pta.x) * (int64_t)(pta.y - pt.y) - (int64_t)(pta.x - pt.x) * (int64_t)(ptb.y - pta.y)) /
-				std::sqrt((int64_t)(ptb.x - pta.x) * (int64_t)(ptb.x - pta.x) + (int64_t)(ptb.y - pta.y) * (int64_t)(ptb.y - pta.y));
-			const auto &link = j->second;
-			if (dist <= 4 && link.Usage() > 0 &&
-					pt.x + 2 >= std::min(pta.x, ptb.x) &&
-					pt.x - 2 <= std::max(pta.x, ptb.x) &&
-					pt.y + 2 >= std::min(pta.y, ptb.y) &&
-					pt.y - 2 <= std::max(pta.y, ptb.y)) {
-				static std::string tooltip_extension;
-				tooltip_extension.clear();
-				/* Fill buf with more information if this is a bidirectional link. */
-				uint32_t back_time = 0;
-				auto k = this->cached_links[j->first].find(i->first);
-				if (k != this->cached_links[j->first].end()) {
-					const auto &back = k->second;
-					back_time = back.time;
-					if (back.Usage() > 0) {
-						tooltip_extension = GetString(STR_LINKGRAPH_STATS_TOOLTIP_RETURN_EXTENSION,
-								back.cargo, back.Usage(), back.Usage() * 100 / (back.capacity + 1));
-					}
-				}
-				/* Add information about the travel time if known. */
-				const auto time = link.time ? back_time ? ((link.time + back_time) / 2) : link.time : back_time;
-				if (time > 0) {
-					auto params = MakeParameters(time);
-					AppendStringWithArgsInPlace(tooltip_extension, STR_LINKGRAPH_STATS_TOOLTIP_TIME_EXTENSION, params);
+	/* The window might have scrolled, or the cache changed, since the overlay was last drawn. */
+	this->RebuildIfDirty();
+
+	for (auto i(this->visible_links.crbegin()); i != this->visible_links.crend(); ++i) {
+		if (!Station::IsValidID(i->from)) continue;
+		if (!Station::IsValidID(i->to)) continue;
+		if (i->from == i->to) continue;
+
+		/* Check the distance from the cursor to the line defined by the two stations. */
+		Point pta = this->GetStationMiddle(Station::Get(i->from));
+		Point ptb = this->GetStationMiddle(Station::Get(i->to));
+		float dist = std::abs((int64_t)(ptb.x - pta.x) * (int64_t)(pta.y - pt.y) - (int64_t)(pta.x - pt.x) * (int64_t)(ptb.y - pta.y)) /
+			std::sqrt((int64_t)(ptb.x - pta.x) * (int64_t)(ptb.x - pta.x) + (int64_t)(ptb.y - pta.y) * (int64_t)(ptb.y - pta.y));
+		const auto &link = *i->properties;
+		if (dist <= 4 && link.Usage() > 0 &&
+				pt.x + 2 >= std::min(pta.x, ptb.x) &&
+				pt.x - 2 <= std::max(pta.x, ptb.x) &&
+				pt.y + 2 >= std::min(pta.y, ptb.y) &&
+				pt.y - 2 <= std::max(pta.y, ptb.y)) {
+			static std::string tooltip_extension;
+			tooltip_extension.clear();
+			/* Fill buf with more information if this is a bidirectional link. */
+			uint32_t back_time = 0;
+			auto k = this->cached_links[i->to].find(i->from);
+			if (k != this->cached_links[i->to].end()) {
+				const auto &back = k->second;
+				back_time = back.time;
+				if (back.Usage() > 0) {
+					tooltip_extension = GetString(STR_LINKGRAPH_STATS_TOOLTIP_RETURN_EXTENSION,
+							back.cargo, back.Usage(), back.Usage() * 100 / (back.capacity + 1));
 				}
-				GuiShowTooltips(this->window,
-					GetEncodedString(TimerGameEconomy::UsingWallclockUnits() ? STR_LINKGRAPH_STATS_TOOLTIP_MINUTE : STR_LINKGRAPH_STATS_TOOLTIP_MONTH,
-						link.cargo, link.Usage(), i->first, j->first, link.Usage() * 100 / (link.capacity + 1), tooltip_extension),
-					close_cond);
-				return true;
 			}
+			/* Add information about the travel time if known. */
+			const auto time = link.time ? back_time ? ((link.time + back_time) / 2) : link.time : back_time;
+			if (time > 0) {
+				auto params = MakeParameters(time);
+				AppendStringWithArgsInPlace(tooltip_extension, STR_LINKGRAPH_STATS_TOOLTIP_TIME_EXTENSION, params);
+			}
+			GuiShowTooltips(this->window,
+				GetEncodedString(TimerGameEconomy::UsingWallclockUnits() ? STR_LINKGRAPH_STATS_TOOLTIP_MINUTE : STR_LINKGRAPH_STATS_TOOLTIP_MONTH,
+					link.cargo, link.Usage(), i->from, i->to, link.Usage() * 100 / (link.capacity + 1), tooltip_extension),
+				close_cond);
+			return true;
 		}
 	}
 	GuiShowTooltips(this->window, {}, close_cond);
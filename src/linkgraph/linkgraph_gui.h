@@ -44,6 +44,13 @@ public:
 	typedef std::map<StationID, StationLinkMap> LinkMap;
 	typedef std::vector<std::pair<StationID, uint> > StationSupplyList;
 
+	/** A link that is (partly) visible in the window. */
+	struct VisibleLink {
+		StationID from; ///< Source station of the link.
+		StationID to; ///< Destination station of the link.
+		const LinkProperties *properties; ///< Statistics of the link, in #cached_links.
+	};
+
 	static const PixelColour LINK_COLOURS[][12];
 
 	/**
@@ -55,7 +62,7 @@ public:
 	 * @param scale Desired thickness of lines and size of station dots.
 	 */
 	LinkGraphOverlay(Window *w, WidgetID wid, CargoTypes cargo_mask, CompanyMask company_mask, uint scale) :
-			window(w), widget_id(wid), cargo_mask(cargo_mask), company_mask(company_mask), scale(scale), dirty(true)
+			window(w), widget_id(wid), cargo_mask(cargo_mask), company_mask(company_mask), visible_size({0, 0}), scale(scale), dirty(true), view_dirty(true)
 	{}
 
 	void Draw(const DrawPixelInfo *dpi);
@@ -67,6 +74,9 @@ public:
 	/** Mark the linkgraph dirty to be rebuilt next time Draw() is called. */
 	void SetDirty() { this->dirty = true; }
 
+	/** Mark the shown part of the linkgraph dirty, e.g. after scrolling, to be determined again next time Draw() is called. */
+	void SetViewDirty() { this->view_dirty = true; }
+
 	/** Get a bitmask of the currently shown cargoes. */
 	CargoTypes GetCargoMask() { return this->cargo_mask; }
 
@@ -78,10 +88,14 @@ protected:
 	const WidgetID widget_id;          ///< ID of Widget in Window to be drawn to.
 	CargoTypes cargo_mask;             ///< Bitmask of cargos to be displayed.
 	CompanyMask company_mask;          ///< Bitmask of companies to be displayed.
-	LinkMap cached_links;              ///< Cache for links to reduce recalculation.
-	StationSupplyList cached_stations; ///< Cache for stations to be drawn.
+	LinkMap cached_links;              ///< Cache for all links of the shown companies and cargoes, wherever they are.
+	StationSupplyList cached_stations; ///< Cache for all stations of the shown companies and cargoes, wherever they are.
+	std::vector<VisibleLink> visible_links; ///< Links from #cached_links crossing the window.
+	StationSupplyList visible_stations; ///< Stations from #cached_stations inside the window.
+	Dimension visible_size;            ///< Size of the window when the visible links and stations were determined.
 	uint scale;                        ///< Width of link lines.
 	bool dirty;                        ///< Set if overlay should be rebuilt.
+	bool view_dirty;                   ///< Set if the visible links and stations should be determined again.
 
 	Point GetStationMiddle(const Station *st) const;
 
@@ -93,6 +107,8 @@ protected:
 	bool IsPointVisible(Point pt, const DrawPixelInfo *dpi, int padding = 0) const;
 	void GetWidgetDpi(DrawPixelInfo *dpi) const;
 	void RebuildCache();
+	void RebuildVisible();
+	void RebuildIfDirty();
 
 	static void AddStats(CargoType new_cargo, uint new_cap, uint new_usg, uint new_flow, uint32_t time, bool new_shared, LinkProperties &cargo);
 	static void DrawVertex(int x, int y, int size, PixelColour colour, PixelColour border_colour);
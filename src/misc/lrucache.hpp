@@ -30,7 +30,7 @@ private:
 	StorageType data; ///< Ordered list of all items.
 	LookupType lookup; ///< Map of keys to items.
 
-	const size_t capacity; ///< Number of items to cache.
+	size_t capacity; ///< Number of items to cache.
 
 public:
 	/**
@@ -39,6 +39,37 @@ public:
 	 */
 	LRUCache(size_t max_items) : capacity(max_items) {}
 
+	/**
+	 * Get the number of items in the cache.
+	 * @return The number of items.
+	 */
+	inline size_t Size() const
+	{
+		return this->data.size();
+	}
+
+	/**
+	 * Get the number of items the cache stores at most.
+	 * @return The capacity.
+	 */
+	inline size_t GetCapacity() const
+	{
+		return this->capacity;
+	}
+
+	/**
+	 * Change the number of items the cache stores at most, removing the least used items if it shrinks.
+	 * @param max_items Number of items to store at most.
+	 */
+	void SetCapacity(size_t max_items)
+	{
+		this->capacity = max_items;
+		while (this->data.size() > this->capacity) {
+			this->lookup.erase(this->data.back().first);
+			this->data.pop_back();
+		}
+	}
+
 	/**
 	 * Test if a key is already contained in the cache.
 	 * @param key The key to search.
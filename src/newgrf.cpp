@@ -1782,6 +1782,17 @@ void LoadNewGRF(SpriteID load_index, uint num_baseset)
 
 	_cur_gps.spriteid = load_index;
 
+	/* Read the sprite sections of all files up front, on multiple threads.
+	 * They are needed for both the init and the activation stage. */
+	std::vector<std::pair<std::string, Subdirectory>> sprite_section_files;
+	for (const auto &c : _grfconfig) {
+		if (c->status == GCS_DISABLED || c->status == GCS_NOT_FOUND) continue;
+
+		Subdirectory subdir = sprite_section_files.size() < num_baseset ? BASESET_DIR : NEWGRF_DIR;
+		if (FioCheckFileExists(c->filename, subdir)) sprite_section_files.emplace_back(c->filename, subdir);
+	}
+	PreloadGRFSpriteOffsets(sprite_section_files);
+
 	/* Load newgrf sprites
 	 * in each loading stage, (try to) open each file specified in the config
 	 * and load information from it. */
@@ -1854,6 +1865,7 @@ void LoadNewGRF(SpriteID load_index, uint num_baseset)
 
 	/* Pseudo sprite processing is finished; free temporary stuff */
 	_cur_gps.ClearDataForNextFile();
+	ClearPreloadedGRFSpriteOffsets();
 
 	/* Call any functions that should be run after GRFs have been loaded. */
 	AfterLoadGRFs();
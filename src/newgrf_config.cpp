@@ -26,6 +26,8 @@
 
 #include "fileio_func.h"
 #include "fios.h"
+#include "ini_type.h"
+#include "core/string_consumer.hpp"
 
 #include "safeguards.h"
 
@@ -292,13 +294,13 @@ static bool CalcGRFMD5Sum(GRFConfig &config, Subdirectory subdir)
 
 
 /**
- * Find the GRFID of a given grf, and calculate its md5sum.
+ * Find the GRFID of a given grf, and read its details, except for the md5sum.
  * @param config    grf to fill.
  * @param is_static grf is static.
  * @param subdir    the subdirectory to search in.
  * @return Operation was successfully completed.
  */
-bool FillGRFDetails(GRFConfig &config, bool is_static, Subdirectory subdir)
+static bool ReadGRFDetails(GRFConfig &config, bool is_static, Subdirectory subdir)
 {
 	if (!FioCheckFileExists(config.filename, subdir)) {
 		config.status = GCS_NOT_FOUND;
@@ -321,7 +323,19 @@ bool FillGRFDetails(GRFConfig &config, bool is_static, Subdirectory subdir)
 		if (config.flags.Test(GRFConfigFlag::Unsafe)) return false;
 	}
 
-	return CalcGRFMD5Sum(config, subdir);
+	return true;
+}
+
+/**
+ * Find the GRFID of a given grf, and calculate its md5sum.
+ * @param config    grf to fill.
+ * @param is_static grf is static.
+ * @param subdir    the subdirectory to search in.
+ * @return Operation was successfully completed.
+ */
+bool FillGRFDetails(GRFConfig &config, bool is_static, Subdirectory subdir)
+{
+	return ReadGRFDetails(config, is_static, subdir) && CalcGRFMD5Sum(config, subdir);
 }
 
 
@@ -486,13 +500,81 @@ compatible_grf:
 }
 
 
+/** Name of the file in the cache directory with the md5sums of previously scanned NewGRFs. */
+static const std::string NEWGRF_SCAN_CACHE_FILE = "newgrf_scan.cfg";
+
+/** Cached md5sum of a NewGRF; it is valid as long as the size and modification time of the file do not change. */
+struct GRFScanCacheEntry {
+	uint64_t size; ///< Size of the file.
+	int64_t mtime; ///< Modification time of the file.
+	MD5Hash md5sum; ///< The md5sum of the file.
+};
+
+/** Cached md5sums of NewGRFs, indexed by the full path of the file. */
+using GRFScanCache = std::map<std::string, GRFScanCacheEntry, std::less<>>;
+
+/**
+ * Load the md5sums of previously scanned NewGRFs from the cache directory.
+ * @return The cached md5sums.
+ */
+static GRFScanCache LoadGRFScanCache()
+{
+	GRFScanCache cache;
+
+	IniFile ini;
+	ini.LoadFromDisk(FioFindDirectory(CACHE_DIR) + NEWGRF_SCAN_CACHE_FILE, NO_DIRECTORY);
+	const IniGroup *group = ini.GetGroup("md5sums");
+	if (group == nullptr) return cache;
+
+	for (const IniItem &item : group->items) {
+		if (!item.value.has_value()) continue;
+
+		StringConsumer consumer(*item.value);
+		auto size = consumer.TryReadIntegerBase<uint64_t>(10);
+		if (!size.has_value() || !consumer.ReadCharIf(',')) continue;
+		auto mtime = consumer.TryReadIntegerBase<int64_t>(10);
+		if (!mtime.has_value() || !consumer.ReadCharIf(',')) continue;
+
+		GRFScanCacheEntry entry{*size, *mtime, {}};
+		if (ConvertHexToBytes(consumer.GetLeftData(), entry.md5sum)) cache.emplace(item.name, entry);
+	}
+
+	return cache;
+}
+
+/**
+ * Save the md5sums of the scanned NewGRFs to the cache directory.
+ * @param cache The md5sums to save.
+ */
+static void SaveGRFScanCache(const GRFScanCache &cache)
+{
+	IniFile ini;
+	IniGroup &group = ini.GetOrCreateGroup("md5sums");
+	for (const auto &[path, entry] : cache) {
+		group.CreateItem(path).SetValue(fmt::format("{},{},{}", entry.size, entry.mtime, FormatArrayAsHex(entry.md5sum)));
+	}
+	ini.SaveToDisk(FioFindDirectory(CACHE_DIR) + NEWGRF_SCAN_CACHE_FILE);
+}
+
 /** Set this flag to prevent any NewGRF scanning from being done. */
 int _skip_all_newgrf_scanning = 0;
 
 /** Helper for scanning for files with GRF as extension */
 class GRFFileScanner : FileScanner {
+	/** A NewGRF found during the scan, of which the md5sum still has to be determined. */
+	struct FoundGRF {
+		std::unique_ptr<GRFConfig> config; ///< The details of the NewGRF.
+		std::string path; ///< Full path of the file, or empty when the file is within a tar file and cannot be cached.
+		uint64_t size = 0; ///< Size of the file.
+		int64_t mtime = 0; ///< Modification time of the file.
+		bool valid = false; ///< Whether the md5sum has been determined.
+	};
+
 	std::chrono::steady_clock::time_point next_update; ///< The next moment we do update the screen.
 	uint num_scanned; ///< The number of GRFs we have scanned.
+	std::vector<FoundGRF> found; ///< The NewGRFs found so far.
+
+	uint AddFoundGRFs();
 
 public:
 	GRFFileScanner() : num_scanned(0)
@@ -511,7 +593,8 @@ public:
 		}
 
 		GRFFileScanner fs;
-		int ret = fs.Scan(".grf", NEWGRF_DIR);
+		fs.Scan(".grf", NEWGRF_DIR);
+		uint ret = fs.AddFoundGRFs();
 		/* The number scanned and the number returned may not be the same;
 		 * duplicate NewGRFs and base sets are ignored in the return value. */
 		_settings_client.gui.last_newgrf_count = fs.num_scanned;
@@ -519,7 +602,7 @@ public:
 	}
 };
 
-bool GRFFileScanner::AddFile(const std::string &filename, size_t basepath_length, const std::string &)
+bool GRFFileScanner::AddFile(const std::string &filename, size_t basepath_length, const std::string &tar_filename)
 {
 	/* Abort if the user stopped the game during a scan. */
 	if (_exit_game) return false;
@@ -527,11 +610,19 @@ bool GRFFileScanner::AddFile(const std::string &filename, size_t basepath_length
 	bool added = false;
 	auto c = std::make_unique<GRFConfig>(filename.substr(basepath_length));
 	GRFConfig *grfconfig = c.get();
-	if (FillGRFDetails(*c, false)) {
-		if (std::ranges::none_of(_all_grfs, [&c](const auto &gc) { return c->ident.grfid == gc->ident.grfid && c->ident.md5sum == gc->ident.md5sum; })) {
-			_all_grfs.push_back(std::move(c));
-			added = true;
+	if (ReadGRFDetails(*c, false, NEWGRF_DIR)) {
+		FoundGRF &found = this->found.emplace_back();
+		found.config = std::move(c);
+
+		/* Files within tar files have no modification time of their own. */
+		std::error_code error_code;
+		std::filesystem::path path(OTTD2FS(filename));
+		if (tar_filename.empty()) {
+			found.size = std::filesystem::file_size(path, error_code);
+			if (!error_code) found.mtime = static_cast<int64_t>(std::filesystem::last_write_time(path, error_code).time_since_epoch().count());
+			if (!error_code) found.path = filename;
 		}
+		added = true;
 	}
 
 	this->num_scanned++;
@@ -543,6 +634,64 @@ bool GRFFileScanner::AddFile(const std::string &filename, size_t basepath_length
 	return added;
 }
 
+/**
+ * Determine the md5sums of the found NewGRFs and add them to the list of all NewGRFs.
+ * The md5sums are taken from the scan cache when the files did not change; the other
+ * files are hashed on multiple threads.
+ * @return The number of NewGRFs added, i.e. excluding duplicates.
+ */
+uint GRFFileScanner::AddFoundGRFs()
+{
+	if (_exit_game) return 0;
+
+	GRFScanCache cache = LoadGRFScanCache();
+	size_t num_cached = cache.size();
+
+	std::vector<FoundGRF *> to_hash;
+	for (FoundGRF &found : this->found) {
+		if (!found.path.empty()) {
+			auto it = cache.find(found.path);
+			if (it != cache.end() && it->second.size == found.size && it->second.mtime == found.mtime) {
+				found.config->ident.md5sum = it->second.md5sum;
+				found.valid = true;
+				continue;
+			}
+		}
+		to_hash.push_back(&found);
+	}
+
+	Debug(grf, 1, "Calculating md5sums of {} NewGRFs, {} taken from the scan cache", to_hash.size(), this->found.size() - to_hash.size());
+	/* Hash a few files per thread at a time, so the progress can be shown in between. */
+	const int batch_size = std::max<int>(std::thread::hardware_concurrency(), 1) * 4;
+	const int num_to_hash = static_cast<int>(to_hash.size());
+	for (int first = 0; first < num_to_hash && !_exit_game; first += batch_size) {
+		int last = std::min(first + batch_size, num_to_hash);
+		ParallelFor(first, last, [&to_hash](int i) {
+			to_hash[i]->valid = CalcGRFMD5Sum(*to_hash[i]->config, NEWGRF_DIR);
+		});
+
+		UpdateNewGRFHashStatus(last, num_to_hash, to_hash[last - 1]->config->GetName());
+		VideoDriver::GetInstance()->GameLoopPause();
+	}
+
+	uint num = 0;
+	cache.clear();
+	for (FoundGRF &found : this->found) {
+		if (!found.valid) continue;
+		if (!found.path.empty()) cache[found.path] = {found.size, found.mtime, found.config->ident.md5sum};
+
+		const GRFConfig &c = *found.config;
+		if (std::ranges::none_of(_all_grfs, [&c](const auto &gc) { return c.ident.grfid == gc->ident.grfid && c.ident.md5sum == gc->ident.md5sum; })) {
+			_all_grfs.push_back(std::move(found.config));
+			num++;
+		}
+	}
+
+	if (!to_hash.empty() || cache.size() != num_cached) SaveGRFScanCache(cache);
+
+	return num;
+}
+
 /**
  * Simple sorter for GRFS
  * @param c1 the first GRFConfig *
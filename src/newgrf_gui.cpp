@@ -2143,6 +2143,8 @@ static WindowDesc _scan_progress_desc(
 struct ScanProgressWindow : public Window {
 	std::string last_name{}; ///< The name of the last 'seen' NewGRF.
 	int scanned = 0; ///< The number of NewGRFs that we have seen.
+	uint hashed = 0; ///< The number of NewGRFs of which the md5sum has been calculated.
+	uint to_hash = 0; ///< The number of NewGRFs of which the md5sum has to be calculated, or 0 while still scanning.
 
 	/** Create the window. */
 	ScanProgressWindow() : Window(_scan_progress_desc)
@@ -2165,6 +2167,7 @@ struct ScanProgressWindow : public Window {
 				/* We really don't know the width. We could determine it by scanning the NewGRFs,
 				 * but this is the status window for scanning them... */
 				size.width = std::max<uint>(size.width, GetStringBoundingBox(GetString(STR_NEWGRF_SCAN_STATUS, max_digits, max_digits)).width + padding.width);
+				size.width = std::max<uint>(size.width, GetStringBoundingBox(GetString(STR_NEWGRF_SCAN_HASH_STATUS, max_digits, max_digits)).width + padding.width);
 				size.height = GetCharacterHeight(FS_NORMAL) * 2 + WidgetDimensions::scaled.vsep_normal;
 				break;
 			}
@@ -2178,14 +2181,18 @@ struct ScanProgressWindow : public Window {
 				/* Draw the % complete with a bar and a text */
 				DrawFrameRect(r, COLOUR_GREY, {FrameFlag::BorderOnly, FrameFlag::Lowered});
 				Rect ir = r.Shrink(WidgetDimensions::scaled.bevel);
-				uint percent = scanned * 100 / std::max(1U, _settings_client.gui.last_newgrf_count);
+				uint percent = this->to_hash != 0 ? this->hashed * 100 / this->to_hash : scanned * 100 / std::max(1U, _settings_client.gui.last_newgrf_count);
 				DrawFrameRect(ir.WithWidth(ir.Width() * percent / 100, _current_text_dir == TD_RTL), COLOUR_MAUVE, {});
 				DrawString(ir.left, ir.right, CentreBounds(ir.top, ir.bottom, GetCharacterHeight(FS_NORMAL)), GetString(STR_GENERATION_PROGRESS, percent), TC_FROMSTRING, SA_HOR_CENTER);
 				break;
 			}
 
 			case WID_SP_PROGRESS_TEXT:
-				DrawString(r.left, r.right, r.top, GetString(STR_NEWGRF_SCAN_STATUS, this->scanned, _settings_client.gui.last_newgrf_count), TC_FROMSTRING, SA_HOR_CENTER);
+				if (this->to_hash != 0) {
+					DrawString(r.left, r.right, r.top, GetString(STR_NEWGRF_SCAN_HASH_STATUS, this->hashed, this->to_hash), TC_FROMSTRING, SA_HOR_CENTER);
+				} else {
+					DrawString(r.left, r.right, r.top, GetString(STR_NEWGRF_SCAN_STATUS, this->scanned, _settings_client.gui.last_newgrf_count), TC_FROMSTRING, SA_HOR_CENTER);
+				}
 
 				DrawString(r.left, r.right, r.top + GetCharacterHeight(FS_NORMAL) + WidgetDimensions::scaled.vsep_normal, this->last_name, TC_BLACK, SA_HOR_CENTER);
 				break;
@@ -2205,6 +2212,21 @@ struct ScanProgressWindow : public Window {
 
 		this->SetDirty();
 	}
+
+	/**
+	 * Update the status of calculating the md5sums of the scanned NewGRFs.
+	 * @param num The number of NewGRFs of which the md5sum has been calculated.
+	 * @param total The number of NewGRFs of which the md5sum has to be calculated.
+	 * @param name The name of the last NewGRF of which the md5sum has been calculated.
+	 */
+	void UpdateNewGRFHashStatus(uint num, uint total, std::string &&name)
+	{
+		this->last_name = std::move(name);
+		this->hashed = num;
+		this->to_hash = total;
+
+		this->SetDirty();
+	}
 };
 
 /**
@@ -2218,3 +2240,16 @@ void UpdateNewGRFScanStatus(uint num, std::string &&name)
 	if (w == nullptr) w = new ScanProgressWindow();
 	w->UpdateNewGRFScanStatus(num, std::move(name));
 }
+
+/**
+ * Update the status of calculating the md5sums of the scanned NewGRFs.
+ * @param num The number of NewGRFs of which the md5sum has been calculated.
+ * @param total The number of NewGRFs of which the md5sum has to be calculated.
+ * @param name The name of the last NewGRF of which the md5sum has been calculated.
+ */
+void UpdateNewGRFHashStatus(uint num, uint total, std::string &&name)
+{
+	ScanProgressWindow *w = dynamic_cast<ScanProgressWindow *>(FindWindowByClass(WC_MODAL_PROGRESS));
+	if (w == nullptr) w = new ScanProgressWindow();
+	w->UpdateNewGRFHashStatus(num, total, std::move(name));
+}
@@ -90,6 +90,8 @@ void ResetHouses()
 
 	/* Reset any overrides that have been set. */
 	_house_mngr.ResetOverride();
+
+	ResetTownHouseCandidates();
 }
 
 /**
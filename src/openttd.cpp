@@ -315,6 +315,7 @@ static void ShutdownGame()
 	/* No NewGRFs were loaded when it was still bootstrapping. */
 	if (_game_mode != GM_BOOTSTRAP) ResetNewGRFData();
 
+	FlushSpriteDiskCaches();
 	UninitFontCache();
 }
 
@@ -263,11 +263,8 @@ void Win32FontCache::ClearFontCache()
 		}
 	}
 
-	UniquePtrSpriteAllocator allocator;
-	BlitterFactory::GetCurrentBlitter()->Encode(SpriteType::Font, spritecollection, allocator);
-
 	GlyphEntry new_glyph;
-	new_glyph.data = std::move(allocator.data);
+	new_glyph.sprite = BlitterFactory::GetCurrentBlitter()->Encode(SpriteType::Font, spritecollection, this->glyph_allocator);
 	new_glyph.width = gm.gmCellIncX;
 
 	return this->SetGlyphPtr(key, std::move(new_glyph)).GetSprite();
@@ -113,7 +113,7 @@ AyStarStatus AyStar::Loop()
 		this->CheckTile(&neighbour, current);
 	}
 
-	if (this->nodes.ClosedCount() >= AYSTAR_DEF_MAX_SEARCH_NODES) {
+	if (this->nodes.ClosedCount() >= this->max_search_nodes) {
 		/* We've expanded enough nodes */
 		return AyStarStatus::LimitReached;
 	} else {
@@ -124,17 +124,20 @@ AyStarStatus AyStar::Loop()
 
 /**
  * This is the function you call to run AyStar.
+ * @param max_loops The maximum number of nodes to handle in this call, or 0 to run till the search is done.
+ *                  When the search is not done yet, call this function again to continue it.
  * @return Possible values:
  *  - #AyStarStatus::FoundEndNode
  *  - #AyStarStatus::NoPath
  *  - #AyStarStatus::StillBusy
  */
-AyStarStatus AyStar::Main()
+AyStarStatus AyStar::Main(int max_loops)
 {
 	AyStarStatus r;
+	int loops = 0;
 	do {
 		r = this->Loop();
-	} while (r == AyStarStatus::StillBusy);
+	} while (r == AyStarStatus::StillBusy && (max_loops == 0 || ++loops < max_loops));
 #ifdef AYSTAR_DEBUG
 	switch (r) {
 		case AyStarStatus::FoundEndNode: Debug(misc, 0, "[AyStar] Found path!"); break;
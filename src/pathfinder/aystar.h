@@ -27,7 +27,7 @@ enum class AyStarStatus : uint8_t {
 	EmptyOpenList, ///< All items are tested, and no path has been found.
 	StillBusy, ///< Some checking was done, but no path found yet, and there are still items left to try.
 	NoPath, ///< No path to the goal was found.
-	LimitReached, ///< The AYSTAR_DEF_MAX_SEARCH_NODES limit has been reached, aborting search.
+	LimitReached, ///< The #AyStar::max_search_nodes limit has been reached, aborting search.
 	Done, ///< Not an end-tile, or wrong direction.
 };
 
@@ -81,7 +81,9 @@ protected:
 
 	void AddStartNode(AyStarNode *start_node, int g);
 
-	AyStarStatus Main();
+	AyStarStatus Main(int max_loops = 0);
+
+	int max_search_nodes = AYSTAR_DEF_MAX_SEARCH_NODES; ///< The maximum number of nodes that will be expanded.
 
 public:
 	virtual ~AyStar() = default;
@@ -1168,6 +1168,16 @@ inline constexpr bool SlCheckVarSize(SaveLoadType cmd, VarType type, size_t leng
  */
 #define SLEG_CONDREFLIST(name, variable, type, from, to) SLEG_GENERAL(name, SL_REFLIST, variable, type, 0, from, to, 0)
 
+/**
+ * Storage of a global reference vector in some savegame versions.
+ * @param name     The name of the field.
+ * @param variable Name of the global variable.
+ * @param type     Storage of the data in memory and in the savegame.
+ * @param from     First savegame version that has the list.
+ * @param to       Last savegame version that has the list.
+ */
+#define SLEG_CONDREFVECTOR(name, variable, type, from, to) SLEG_GENERAL(name, SL_REFVECTOR, variable, type, 0, from, to, 0)
+
 /**
  * Storage of a global vector of #SL_VAR elements in some savegame versions.
  * @param name     The name of the field.
@@ -28,6 +28,8 @@
 #include "video/video_driver.hpp"
 #include "smallmap_gui.h"
 #include "screenshot_type.h"
+#include "fios.h"
+#include "debug.h"
 
 #include "table/strings.h"
 
@@ -284,6 +286,163 @@ static bool MakeLargeWorldScreenshot(ScreenshotType t, uint32_t width = 0, uint3
 			}, vp.width, vp.height, BlitterFactory::GetCurrentBlitter()->GetScreenDepth(), _cur_palette.palette);
 }
 
+/** Width and height in pixels of the images of a tiled world export. */
+static const int EXPORT_TILE_SIZE = 256;
+/** Width and height in virtual pixels of the area of the map shown by an image at the most detailed zoom level of a tiled world export. */
+static const int EXPORT_CELL_SIZE = EXPORT_TILE_SIZE << to_underlying(ZoomLevel::WorldScreenshot);
+
+/**
+ * State of the tiled world export, so the next export only renders the parts of the map that changed.
+ * The exported area is divided into cells, one for each image at the most detailed zoom level.
+ */
+struct TiledWorldExport {
+	int virtual_left;   ///< Left edge of the exported area, in virtual pixels.
+	int virtual_top;    ///< Top edge of the exported area, in virtual pixels.
+	int virtual_width;  ///< Width of the exported area, in virtual pixels.
+	int virtual_height; ///< Height of the exported area, in virtual pixels.
+	int columns;        ///< Number of columns of cells.
+	int rows;           ///< Number of rows of cells.
+	std::vector<bool> dirty; ///< For every cell, whether it changed since the previous export.
+
+	/**
+	 * Check whether any cell in a square of cells changed since the previous export.
+	 * @param column The column of the top left cell.
+	 * @param row The row of the top left cell.
+	 * @param cells The width and height of the square, in cells.
+	 * @return True iff any of the cells changed.
+	 */
+	bool IsDirty(int column, int row, int cells) const
+	{
+		for (int y = row; y < std::min(row + cells, this->rows); y++) {
+			for (int x = column; x < std::min(column + cells, this->columns); x++) {
+				if (this->dirty[y * this->columns + x]) return true;
+			}
+		}
+		return false;
+	}
+};
+
+static std::optional<TiledWorldExport> _tiled_world_export; ///< The state of the previous tiled world export, if any.
+
+/**
+ * Mark an area of the map as changed for the tiled world export.
+ * @param left Left edge of the area, in virtual pixels.
+ * @param top Top edge of the area, in virtual pixels.
+ * @param right Right edge of the area, in virtual pixels.
+ * @param bottom Bottom edge of the area, in virtual pixels.
+ */
+void MarkTiledWorldExportDirty(int left, int top, int right, int bottom)
+{
+	if (!_tiled_world_export.has_value()) return;
+	TiledWorldExport &e = *_tiled_world_export;
+
+	left -= e.virtual_left;
+	right -= e.virtual_left;
+	top -= e.virtual_top;
+	bottom -= e.virtual_top;
+	if (right <= 0 || bottom <= 0 || left >= e.virtual_width || top >= e.virtual_height) return;
+
+	int first_column = std::max(left, 0) / EXPORT_CELL_SIZE;
+	int last_column = (std::min(right, e.virtual_width) - 1) / EXPORT_CELL_SIZE;
+	int first_row = std::max(top, 0) / EXPORT_CELL_SIZE;
+	int last_row = (std::min(bottom, e.virtual_height) - 1) / EXPORT_CELL_SIZE;
+	for (int row = first_row; row <= last_row; row++) {
+		for (int column = first_column; column <= last_column; column++) {
+			e.dirty[row * e.columns + column] = true;
+		}
+	}
+}
+
+/** Forget about the previous tiled world export, so the next export renders the whole map. */
+void ResetTiledWorldExport()
+{
+	_tiled_world_export.reset();
+}
+
+/**
+ * Export the whole map as a pyramid of images, for use by web map viewers.
+ * The images are written to "tiles/<level>/<x>/<y>.<ext>" in the screenshot directory, where level 0
+ * is the most zoomed out level. Only images of which the shown part of the map changed since the
+ * previous export are rendered again.
+ * @param full Render all images, even when their part of the map did not change.
+ * @return true on success
+ */
+static bool RealMakeTiledWorldExport(bool full)
+{
+	auto provider = GetScreenshotProvider();
+	if (provider == nullptr) return false;
+
+	/* Align the exported area, so the images of all zoom levels start at whole pixels. */
+	Viewport world = SetupScreenshotViewport(SC_WORLD);
+	int mask = ScaleByZoom(-1, ZoomLevel::Max);
+	int left = world.virtual_left & mask;
+	int top = world.virtual_top & mask;
+	int width = world.virtual_left + world.virtual_width - left;
+	int height = world.virtual_top + world.virtual_height - top;
+
+	if (full || !_tiled_world_export.has_value() || _tiled_world_export->virtual_left != left || _tiled_world_export->virtual_top != top ||
+			_tiled_world_export->virtual_width != width || _tiled_world_export->virtual_height != height) {
+		TiledWorldExport &e = _tiled_world_export.emplace(left, top, width, height, CeilDiv(width, EXPORT_CELL_SIZE), CeilDiv(height, EXPORT_CELL_SIZE));
+		e.dirty.assign(static_cast<size_t>(e.columns) * e.rows, true);
+	}
+	TiledWorldExport &e = *_tiled_world_export;
+
+	std::string base = fmt::format("{}tiles{}", FiosGetScreenshotDir(), PATHSEP);
+	int depth = BlitterFactory::GetCurrentBlitter()->GetScreenDepth();
+	uint rendered = 0;
+	for (ZoomLevel zoom = ZoomLevel::WorldScreenshot; zoom <= ZoomLevel::Max; zoom++) {
+		int cells = 1 << (to_underlying(zoom) - to_underlying(ZoomLevel::WorldScreenshot));
+		int level = to_underlying(ZoomLevel::Max) - to_underlying(zoom);
+
+		for (int x = 0; x * cells < e.columns; x++) {
+			std::string directory = fmt::format("{}{}{}{}{}", base, level, PATHSEP, x, PATHSEP);
+			bool created = false;
+
+			for (int y = 0; y * cells < e.rows; y++) {
+				if (!e.IsDirty(x * cells, y * cells, cells)) continue;
+
+				if (!created) {
+					FioCreateDirectory(directory);
+					created = true;
+				}
+
+				Viewport vp{};
+				vp.zoom = zoom;
+				vp.virtual_left = left + x * cells * EXPORT_CELL_SIZE;
+				vp.virtual_top = top + y * cells * EXPORT_CELL_SIZE;
+				vp.virtual_width = cells * EXPORT_CELL_SIZE;
+				vp.virtual_height = cells * EXPORT_CELL_SIZE;
+				vp.width = EXPORT_TILE_SIZE;
+				vp.height = EXPORT_TILE_SIZE;
+				vp.overlay = nullptr;
+
+				bool ret = provider->MakeImage(fmt::format("{}{}.{}", directory, y, provider->GetName()),
+						[&vp](void *buf, uint line, uint pitch, uint n) {
+							LargeWorldCallback(vp, buf, line, pitch, n);
+						}, EXPORT_TILE_SIZE, EXPORT_TILE_SIZE, depth, _cur_palette.palette);
+				if (!ret) return false;
+				rendered++;
+			}
+		}
+	}
+
+	std::fill(e.dirty.begin(), e.dirty.end(), false);
+	Debug(misc, 1, "Exported {} map tiles to {}", rendered, base);
+	return true;
+}
+
+/**
+ * Schedule a tiled export of the world.
+ * @param full Render all images, even when their part of the map did not change since the previous export.
+ * @see RealMakeTiledWorldExport
+ */
+void MakeTiledWorldExport(bool full)
+{
+	VideoDriver::GetInstance()->QueueOnMainThread([full] {
+		if (!RealMakeTiledWorldExport(full)) ShowErrorMessage(GetEncodedString(STR_ERROR_SCREENSHOT_FAILED), {}, WL_ERROR);
+	});
+}
+
 /**
  * Callback for generating a heightmap. Supports 8bpp grayscale only.
  * @param buffer   Destination buffer.
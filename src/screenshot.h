@@ -27,6 +27,9 @@ bool MakeHeightmapScreenshot(std::string_view filename);
 void MakeScreenshotWithConfirm(ScreenshotType t);
 bool MakeScreenshot(ScreenshotType t, const std::string &name, uint32_t width = 0, uint32_t height = 0);
 bool MakeMinimapWorldScreenshot();
+void MakeTiledWorldExport(bool full);
+void MarkTiledWorldExportDirty(int left, int top, int right, int bottom);
+void ResetTiledWorldExport();
 
 extern std::string _screenshot_format_name;
 extern std::string _full_screenshot_path;
@@ -12,9 +12,12 @@
 #include "debug.h"
 #include "fileio_func.h"
 #include "screenshot_type.h"
+#include "thread.h"
 #include "3rdparty/fmt/ranges.h"
 
 #include <png.h>
+#include <condition_variable>
+#include <deque>
 
 #ifdef PNG_TEXT_SUPPORTED
 #include "rev.h"
@@ -28,6 +31,117 @@
 #include "safeguards.h"
 
 class ScreenshotProvider_Png : public ScreenshotProvider {
+	/** Images with fewer pixels than this are written without a separate thread; that includes screenshots of the screen, e.g. for crash logs. */
+	static constexpr uint64_t THREADED_MIN_PIXELS = 1U << 24;
+
+	/**
+	 * Strips of rendered lines, handed from the thread rendering them to the thread compressing and writing them.
+	 * The number of buffers bounds the memory used, regardless of the size of the image.
+	 */
+	struct StripQueue {
+		std::mutex lock; ///< Lock for the queues and flags.
+		std::condition_variable changed; ///< Signalled whenever the queues or flags change.
+		std::array<std::vector<uint8_t>, 2> buffers; ///< The buffers to render the strips into.
+		std::vector<size_t> free; ///< Buffers that can be rendered into.
+		std::deque<std::pair<size_t, uint>> filled; ///< Rendered buffers and their number of lines, in order of the image.
+		bool done = false; ///< Whether all strips have been rendered.
+		bool failed = false; ///< Whether writing the image failed.
+	};
+
+	/**
+	 * Compress and write the rendered strips, and finish the image once all strips have been written.
+	 * @param png_ptr The image being written.
+	 * @param info_ptr The information of the image.
+	 * @param queue The strips to write.
+	 * @param row_size The number of bytes in a line.
+	 */
+	static void WriteStrips(png_structp png_ptr, png_infop info_ptr, StripQueue *queue, size_t row_size)
+	{
+		/* libpng reports errors by jumping back to here, so no objects with destructors may be alive while it runs. */
+		if (setjmp(png_jmpbuf(png_ptr))) {
+			std::lock_guard<std::mutex> lock(queue->lock);
+			queue->failed = true;
+			queue->changed.notify_all();
+			return;
+		}
+
+		for (;;) {
+			size_t index;
+			uint n;
+			{
+				std::unique_lock<std::mutex> lock(queue->lock);
+				queue->changed.wait(lock, [queue]() { return !queue->filled.empty() || queue->done; });
+				if (queue->filled.empty()) break;
+				std::tie(index, n) = queue->filled.front();
+				queue->filled.pop_front();
+			}
+
+			for (uint i = 0; i != n; i++) {
+				png_write_row(png_ptr, queue->buffers[index].data() + i * row_size);
+			}
+
+			std::lock_guard<std::mutex> lock(queue->lock);
+			queue->free.push_back(index);
+			queue->changed.notify_all();
+		}
+
+		png_write_end(png_ptr, info_ptr);
+	}
+
+	/**
+	 * Render the image strip by strip, while the previous strip is compressed and written by a separate thread.
+	 * @param png_ptr The image being written.
+	 * @param info_ptr The information of the image.
+	 * @param callb The callback rendering the lines.
+	 * @param w The width of the image.
+	 * @param h The height of the image.
+	 * @param bpp The number of bytes per pixel.
+	 * @param maxlines The maximum number of lines in a strip.
+	 * @return Whether the image has been written, or std::nullopt when no thread could be started for writing.
+	 */
+	static std::optional<bool> WriteImageThreaded(png_structp png_ptr, png_infop info_ptr, const ScreenshotCallback &callb, uint w, uint h, uint bpp, uint maxlines)
+	{
+		StripQueue queue;
+		for (size_t i = 0; i < queue.buffers.size(); i++) {
+			queue.buffers[i].resize(static_cast<size_t>(w) * maxlines * bpp);
+			queue.free.push_back(i);
+		}
+
+		std::thread writer;
+		size_t row_size = static_cast<size_t>(w) * bpp;
+		if (!StartNewThread(&writer, "ottd:screenshot", [png_ptr, info_ptr, &queue, row_size]() { WriteStrips(png_ptr, info_ptr, &queue, row_size); })) return std::nullopt;
+
+		uint y = 0;
+		do {
+			size_t index;
+			{
+				std::unique_lock<std::mutex> lock(queue.lock);
+				queue.changed.wait(lock, [&queue]() { return !queue.free.empty() || queue.failed; });
+				if (queue.failed) break;
+				index = queue.free.back();
+				queue.free.pop_back();
+			}
+
+			/* render the pixels into the buffer */
+			uint n = std::min(h - y, maxlines);
+			callb(queue.buffers[index].data(), y, w, n);
+			y += n;
+
+			std::lock_guard<std::mutex> lock(queue.lock);
+			queue.filled.emplace_back(index, n);
+			queue.changed.notify_all();
+		} while (y != h);
+
+		{
+			std::lock_guard<std::mutex> lock(queue.lock);
+			queue.done = true;
+			queue.changed.notify_all();
+		}
+		writer.join();
+
+		return !queue.failed;
+	}
+
 public:
 	ScreenshotProvider_Png() : ScreenshotProvider("png", "PNG", 0) {}
 
@@ -142,6 +256,15 @@ public:
 		/* use by default 64k temp memory */
 		maxlines = Clamp(65536 / w, 16, 128);
 
+		/* Rendering and compressing large images both take long, so let them run at the same time. */
+		if (static_cast<uint64_t>(w) * h >= THREADED_MIN_PIXELS) {
+			std::optional<bool> threaded = WriteImageThreaded(png_ptr, info_ptr, callb, w, h, bpp, maxlines);
+			if (threaded.has_value()) {
+				png_destroy_write_struct(&png_ptr, &info_ptr);
+				return *threaded;
+			}
+		}
+
 		/* now generate the bitmap bits */
 		std::vector<uint8_t> buff(static_cast<size_t>(w) * maxlines * bpp); // by default generate 128 lines at a time.
 
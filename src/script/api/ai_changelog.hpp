@@ -28,6 +28,14 @@
  * \li AICargo::CC_POTABLE
  * \li AICargo::CC_NON_POTABLE
  * \li AIVehicleList_Waypoint
+ * \li AITileList::ValuateBuildable
+ * \li AITileList::ValuateSlope
+ * \li AITileList::ValuateMinHeight
+ * \li AITileList::ValuateMaxHeight
+ * \li AITileList::ValuateOwner
+ * \li AITileList::ValuateDistanceManhattanToTile
+ * \li AITileList::ValuateDistanceSquareToTile
+ * \li AIRoadPathFinder
  *
  * Other changes:
  * \li AIBridge::GetBridgeID renamed to AIBridge::GetBridgeType
@@ -28,6 +28,14 @@
  * \li GSCargo::CC_POTABLE
  * \li GSCargo::CC_NON_POTABLE
  * \li GSVehicleList_Waypoint
+ * \li GSTileList::ValuateBuildable
+ * \li GSTileList::ValuateSlope
+ * \li GSTileList::ValuateMinHeight
+ * \li GSTileList::ValuateMaxHeight
+ * \li GSTileList::ValuateOwner
+ * \li GSTileList::ValuateDistanceManhattanToTile
+ * \li GSTileList::ValuateDistanceSquareToTile
+ * \li GSRoadPathFinder
  * \li GSBaseStation::GetOwner
  *
  * Other changes:
@@ -15,394 +15,105 @@
 #include "../../safeguards.h"
 
 /**
- * Base class for any ScriptList sorter.
+ * Iterator over a ScriptList in the order of the chosen sorter.
+ * It remembers the next entry it will return, so when the list is modified
+ * during the iteration it continues from where that entry is (or was).
  */
 class ScriptListSorter {
-protected:
-	ScriptList *list;       ///< The list that's being sorted.
-	bool has_no_more_items; ///< Whether we have more items to iterate over.
-	SQInteger item_next;    ///< The next item we will show.
-
-public:
-	/**
-	 * Virtual dtor, needed to mute warnings.
-	 */
-	virtual ~ScriptListSorter() = default;
-
-	/**
-	 * Get the first item of the sorter.
-	 */
-	virtual SQInteger Begin() = 0;
-
-	/**
-	 * Stop iterating a sorter.
-	 */
-	virtual void End() = 0;
-
-	/**
-	 * Get the next item of the sorter.
-	 */
-	virtual SQInteger Next() = 0;
-
-	/**
-	 * See if the sorter has reached the end.
-	 */
-	bool IsEnd()
-	{
-		return this->list->buckets.empty() || this->has_no_more_items;
-	}
-
-	/**
-	 * Callback from the list if an item gets removed.
-	 */
-	virtual void Remove(SQInteger item) = 0;
+private:
+	ScriptList *list;               ///< The list that's being sorted.
+	ScriptList::SorterType type;    ///< What to sort the list by.
+	bool ascending;                 ///< Whether to sort ascending or descending.
+	bool has_no_more_items = true;  ///< Whether we have more items to iterate over.
+	std::optional<ScriptList::ScriptListEntry> next; ///< The next entry we will show.
+	int next_modifications = 0;     ///< Modification count of the list when #next was determined.
 
 	/**
-	 * Attach the sorter to a new list. This assumes the content of the old list has been moved to
-	 * the new list, too, so that we don't have to invalidate any iterators. Note that std::swap
-	 * doesn't invalidate iterators on lists and maps, so that should be safe.
-	 * @param target New list to attach to.
+	 * Find the next item, and store that information.
+	 * @param from The entry to start from, or \c nullptr to start at the beginning.
+	 * @param inclusive Whether \a from itself may be the next entry.
 	 */
-	virtual void Retarget(ScriptList *new_list)
+	void FindNext(const ScriptList::ScriptListEntry *from, bool inclusive)
 	{
-		this->list = new_list;
+		this->next = this->list->FindEntry(this->type, from, this->ascending, inclusive);
+		this->next_modifications = this->list->modifications;
 	}
-};
-
-/**
- * Sort by value, ascending.
- */
-class ScriptListSorterValueAscending : public ScriptListSorter {
-private:
-	ScriptList::ScriptListBucket::iterator bucket_iter;    ///< The iterator over the list to find the buckets.
-	ScriptList::ScriptItemList *bucket_list;               ///< The current bucket list we're iterator over.
-	ScriptList::ScriptItemList::iterator bucket_list_iter; ///< The iterator over the bucket list.
 
 public:
 	/**
 	 * Create a new sorter.
 	 * @param list The list to sort.
+	 * @param type What to sort the list by.
+	 * @param ascending Whether to sort ascending or descending.
 	 */
-	ScriptListSorterValueAscending(ScriptList *list)
-	{
-		this->list = list;
-		this->End();
-	}
-
-	SQInteger Begin() override
-	{
-		if (this->list->buckets.empty()) return 0;
-		this->has_no_more_items = false;
-
-		this->bucket_iter = this->list->buckets.begin();
-		this->bucket_list = &(*this->bucket_iter).second;
-		this->bucket_list_iter = this->bucket_list->begin();
-		this->item_next = *this->bucket_list_iter;
-
-		SQInteger item_current = this->item_next;
-		FindNext();
-		return item_current;
-	}
-
-	void End() override
-	{
-		this->bucket_list = nullptr;
-		this->has_no_more_items = true;
-		this->item_next = 0;
-	}
+	ScriptListSorter(ScriptList *list, ScriptList::SorterType type, bool ascending) : list(list), type(type), ascending(ascending) {}
 
 	/**
-	 * Find the next item, and store that information.
+	 * Get the first item of the sorter.
 	 */
-	void FindNext()
+	SQInteger Begin()
 	{
-		if (this->bucket_list == nullptr) {
-			this->has_no_more_items = true;
-			return;
+		this->FindNext(nullptr, true);
+		if (!this->next.has_value()) {
+			this->End();
+			return 0;
 		}
+		this->has_no_more_items = false;
 
-		this->bucket_list_iter++;
-		if (this->bucket_list_iter == this->bucket_list->end()) {
-			this->bucket_iter++;
-			if (this->bucket_iter == this->list->buckets.end()) {
-				this->bucket_list = nullptr;
-				return;
-			}
-			this->bucket_list = &(*this->bucket_iter).second;
-			this->bucket_list_iter = this->bucket_list->begin();
-		}
-		this->item_next = *this->bucket_list_iter;
-	}
-
-	SQInteger Next() override
-	{
-		if (this->IsEnd()) return 0;
-
-		SQInteger item_current = this->item_next;
-		FindNext();
-		return item_current;
-	}
-
-	void Remove(SQInteger item) override
-	{
-		if (this->IsEnd()) return;
-
-		/* If we remove the 'next' item, skip to the next */
-		if (item == this->item_next) {
-			FindNext();
-			return;
-		}
+		ScriptList::ScriptListEntry current = *this->next;
+		this->FindNext(&current, false);
+		return current.item;
 	}
-};
-
-/**
- * Sort by value, descending.
- */
-class ScriptListSorterValueDescending : public ScriptListSorter {
-private:
-	/* Note: We cannot use reverse_iterator.
-	 *       The iterators must only be invalidated when the element they are pointing to is removed.
-	 *       This only holds for forward iterators. */
-	ScriptList::ScriptListBucket::iterator bucket_iter;    ///< The iterator over the list to find the buckets.
-	ScriptList::ScriptItemList *bucket_list;               ///< The current bucket list we're iterator over.
-	ScriptList::ScriptItemList::iterator bucket_list_iter; ///< The iterator over the bucket list.
 
-public:
 	/**
-	 * Create a new sorter.
-	 * @param list The list to sort.
+	 * Stop iterating a sorter.
 	 */
-	ScriptListSorterValueDescending(ScriptList *list)
+	void End()
 	{
-		this->list = list;
-		this->End();
-	}
-
-	SQInteger Begin() override
-	{
-		if (this->list->buckets.empty()) return 0;
-		this->has_no_more_items = false;
-
-		/* Go to the end of the bucket-list */
-		this->bucket_iter = this->list->buckets.end();
-		--this->bucket_iter;
-		this->bucket_list = &(*this->bucket_iter).second;
-
-		/* Go to the end of the items in the bucket */
-		this->bucket_list_iter = this->bucket_list->end();
-		--this->bucket_list_iter;
-		this->item_next = *this->bucket_list_iter;
-
-		SQInteger item_current = this->item_next;
-		FindNext();
-		return item_current;
-	}
-
-	void End() override
-	{
-		this->bucket_list = nullptr;
 		this->has_no_more_items = true;
-		this->item_next = 0;
+		this->next.reset();
 	}
 
 	/**
-	 * Find the next item, and store that information.
+	 * Get the next item of the sorter.
 	 */
-	void FindNext()
-	{
-		if (this->bucket_list == nullptr) {
-			this->has_no_more_items = true;
-			return;
-		}
-
-		if (this->bucket_list_iter == this->bucket_list->begin()) {
-			if (this->bucket_iter == this->list->buckets.begin()) {
-				this->bucket_list = nullptr;
-				return;
-			}
-			this->bucket_iter--;
-			this->bucket_list = &(*this->bucket_iter).second;
-			/* Go to the end of the items in the bucket */
-			this->bucket_list_iter = this->bucket_list->end();
-			--this->bucket_list_iter;
-		} else {
-			this->bucket_list_iter--;
-		}
-		this->item_next = *this->bucket_list_iter;
-	}
-
-	SQInteger Next() override
+	SQInteger Next()
 	{
 		if (this->IsEnd()) return 0;
 
-		SQInteger item_current = this->item_next;
-		FindNext();
-		return item_current;
-	}
-
-	void Remove(SQInteger item) override
-	{
-		if (this->IsEnd()) return;
-
-		/* If we remove the 'next' item, skip to the next */
-		if (item == this->item_next) {
-			FindNext();
-			return;
+		/* When the list changed, the next entry might have been removed or got another value; continue from where it was. */
+		if (this->next.has_value() && this->next_modifications != this->list->modifications) {
+			ScriptList::ScriptListEntry old_next = *this->next;
+			this->FindNext(&old_next, true);
 		}
-	}
-};
-
-/**
- * Sort by item, ascending.
- */
-class ScriptListSorterItemAscending : public ScriptListSorter {
-private:
-	ScriptList::ScriptListMap::iterator item_iter; ///< The iterator over the items in the map.
-
-public:
-	/**
-	 * Create a new sorter.
-	 * @param list The list to sort.
-	 */
-	ScriptListSorterItemAscending(ScriptList *list)
-	{
-		this->list = list;
-		this->End();
-	}
-
-	SQInteger Begin() override
-	{
-		if (this->list->items.empty()) return 0;
-		this->has_no_more_items = false;
-
-		this->item_iter = this->list->items.begin();
-		this->item_next = (*this->item_iter).first;
-
-		SQInteger item_current = this->item_next;
-		FindNext();
-		return item_current;
-	}
-
-	void End() override
-	{
-		this->has_no_more_items = true;
-	}
-
-	/**
-	 * Find the next item, and store that information.
-	 */
-	void FindNext()
-	{
-		if (this->item_iter == this->list->items.end()) {
+		if (!this->next.has_value()) {
 			this->has_no_more_items = true;
-			return;
+			return 0;
 		}
-		this->item_iter++;
-		if (this->item_iter != this->list->items.end()) item_next = (*this->item_iter).first;
-	}
-
-	SQInteger Next() override
-	{
-		if (this->IsEnd()) return 0;
 
-		SQInteger item_current = this->item_next;
-		FindNext();
-		return item_current;
+		ScriptList::ScriptListEntry current = *this->next;
+		this->FindNext(&current, false);
+		return current.item;
 	}
 
-	void Remove(SQInteger item) override
-	{
-		if (this->IsEnd()) return;
-
-		/* If we remove the 'next' item, skip to the next */
-		if (item == this->item_next) {
-			FindNext();
-			return;
-		}
-	}
-};
-
-/**
- * Sort by item, descending.
- */
-class ScriptListSorterItemDescending : public ScriptListSorter {
-private:
-	/* Note: We cannot use reverse_iterator.
-	 *       The iterators must only be invalidated when the element they are pointing to is removed.
-	 *       This only holds for forward iterators. */
-	ScriptList::ScriptListMap::iterator item_iter; ///< The iterator over the items in the map.
-
-public:
 	/**
-	 * Create a new sorter.
-	 * @param list The list to sort.
+	 * See if the sorter has reached the end.
 	 */
-	ScriptListSorterItemDescending(ScriptList *list)
-	{
-		this->list = list;
-		this->End();
-	}
-
-	SQInteger Begin() override
-	{
-		if (this->list->items.empty()) return 0;
-		this->has_no_more_items = false;
-
-		this->item_iter = this->list->items.end();
-		--this->item_iter;
-		this->item_next = (*this->item_iter).first;
-
-		SQInteger item_current = this->item_next;
-		FindNext();
-		return item_current;
-	}
-
-	void End() override
+	bool IsEnd()
 	{
-		this->has_no_more_items = true;
+		return this->list->IsEmpty() || this->has_no_more_items;
 	}
 
 	/**
-	 * Find the next item, and store that information.
+	 * Attach the sorter to a new list, after the content of the old list has been moved to it.
+	 * @param new_list New list to attach to.
 	 */
-	void FindNext()
+	void Retarget(ScriptList *new_list)
 	{
-		if (this->item_iter == this->list->items.end()) {
-			this->has_no_more_items = true;
-			return;
-		}
-		if (this->item_iter == this->list->items.begin()) {
-			/* Use 'end' as marker for 'beyond begin' */
-			this->item_iter = this->list->items.end();
-		} else {
-			this->item_iter--;
-		}
-		if (this->item_iter != this->list->items.end()) item_next = (*this->item_iter).first;
-	}
-
-	SQInteger Next() override
-	{
-		if (this->IsEnd()) return 0;
-
-		SQInteger item_current = this->item_next;
-		FindNext();
-		return item_current;
-	}
-
-	void Remove(SQInteger item) override
-	{
-		if (this->IsEnd()) return;
-
-		/* If we remove the 'next' item, skip to the next */
-		if (item == this->item_next) {
-			FindNext();
-			return;
-		}
+		this->list = new_list;
 	}
 };
 
-
-
 bool ScriptList::SaveObject(HSQUIRRELVM vm)
 {
 	sq_pushstring(vm, "List");
@@ -412,9 +123,9 @@ bool ScriptList::SaveObject(HSQUIRRELVM vm)
 	sq_pushbool(vm, this->sort_ascending ? SQTrue : SQFalse);
 	sq_arrayappend(vm, -2);
 	sq_newtable(vm);
-	for (ScriptListMap::iterator iter = this->items.begin(); iter != this->items.end(); iter++) {
-		sq_pushinteger(vm, iter->first);
-		sq_pushinteger(vm, iter->second);
+	for (const ScriptListEntry &entry : this->GetItemOrder()) {
+		sq_pushinteger(vm, entry.item);
+		sq_pushinteger(vm, entry.value);
 		sq_rawset(vm, -3);
 	}
 	sq_arrayappend(vm, -2);
@@ -464,13 +175,20 @@ void ScriptList::CopyList(const ScriptList *list)
 {
 	this->Sort(list->sorter_type, list->sort_ascending);
 	this->items = list->items;
-	this->buckets = list->buckets;
+	this->added_items = list->added_items;
+	this->removed_items = list->removed_items;
+	this->values = list->values;
+	this->added_values = list->added_values;
+	this->outdated_values = list->outdated_values;
+	this->values_sorted = list->values_sorted;
 }
 
 ScriptList::ScriptList()
 {
+	this->outdated_values = 0;
+	this->values_sorted  = true;
 	/* Default sorter */
-	this->sorter         = std::make_unique<ScriptListSorterValueDescending>(this);
+	this->sorter         = std::make_unique<ScriptListSorter>(this, SORT_BY_VALUE, false);
 	this->sorter_type    = SORT_BY_VALUE;
 	this->sort_ascending = false;
 	this->initialized    = false;
@@ -481,9 +199,229 @@ ScriptList::~ScriptList()
 {
 }
 
+/**
+ * Order of list entries by item.
+ * @param a The first entry.
+ * @param b The second entry.
+ * @return True iff \a a comes before \a b.
+ */
+/* static */ bool ScriptList::ItemLess(const ScriptListEntry &a, const ScriptListEntry &b)
+{
+	return a.item < b.item;
+}
+
+/**
+ * Order of list entries by value, and by item for entries with the same value.
+ * @param a The first entry.
+ * @param b The second entry.
+ * @return True iff \a a comes before \a b.
+ */
+/* static */ bool ScriptList::ValueLess(const ScriptListEntry &a, const ScriptListEntry &b)
+{
+	return std::tie(a.value, a.item) < std::tie(b.value, b.item);
+}
+
+/**
+ * Merge the added and removed items into #items.
+ */
+void ScriptList::MergeItems()
+{
+	if (this->added_items.empty() && this->removed_items.empty()) return;
+
+	ScriptListEntries merged;
+	merged.reserve(this->items.size() - this->removed_items.size() + this->added_items.size());
+
+	auto added = this->added_items.begin();
+	auto removed = this->removed_items.begin();
+	for (const ScriptListEntry &entry : this->items) {
+		for (; added != this->added_items.end() && added->first < entry.item; ++added) merged.push_back({added->first, added->second});
+		if (removed != this->removed_items.end() && *removed == entry.item) {
+			++removed;
+			continue;
+		}
+		merged.push_back(entry);
+	}
+	for (; added != this->added_items.end(); ++added) merged.push_back({added->first, added->second});
+
+	this->items = std::move(merged);
+	this->added_items.clear();
+	this->removed_items.clear();
+}
+
+/**
+ * Merge the changes to single items into the vectors once there are many of them,
+ * so looking up items and walking the list stay fast.
+ */
+void ScriptList::MergeChanges()
+{
+	size_t limit = 64 + this->items.size() / 8;
+	if (this->added_items.size() + this->removed_items.size() > limit) this->MergeItems();
+	if (this->added_values.size() + this->outdated_values > limit) this->InvalidateValueOrder();
+}
+
+/**
+ * Forget the order of the entries by value; it is determined again when it is needed.
+ */
+void ScriptList::InvalidateValueOrder()
+{
+	this->values.clear();
+	this->added_values.clear();
+	this->outdated_values = 0;
+	this->values_sorted = false;
+}
+
+/**
+ * Update the order by value for an entry that is no longer in the list.
+ * @param entry The item and the value it had.
+ */
+void ScriptList::ValueRemoved(const ScriptListEntry &entry)
+{
+	if (!this->values_sorted) return;
+
+	/* When the entry was not added since the order was determined, it is in #values. */
+	if (this->added_values.erase(entry) == 0) this->outdated_values++;
+}
+
+/**
+ * Update the order by value for an entry that is new to the list.
+ * @param entry The item and its value.
+ */
+void ScriptList::ValueAdded(const ScriptListEntry &entry)
+{
+	if (!this->values_sorted) return;
+
+	/* The item might get back the value it had when the order was determined. */
+	if (std::binary_search(this->values.begin(), this->values.end(), entry, ValueLess)) {
+		this->outdated_values--;
+	} else {
+		this->added_values.insert(entry);
+	}
+}
+
+/**
+ * Get the entries of the list sorted by item.
+ * @return The sorted entries.
+ */
+const ScriptList::ScriptListEntries &ScriptList::GetItemOrder()
+{
+	this->MergeItems();
+	return this->items;
+}
+
+/**
+ * Get the entries of the list sorted by value. The order is only
+ * determined when it is needed, so valuating all items sorts just once.
+ * @return The sorted entries.
+ */
+const ScriptList::ScriptListEntries &ScriptList::GetValueOrder()
+{
+	if (!this->added_values.empty() || this->outdated_values != 0) this->InvalidateValueOrder();
+	if (!this->values_sorted) {
+		this->values = this->GetItemOrder();
+		std::sort(this->values.begin(), this->values.end(), ValueLess);
+		this->values_sorted = true;
+	}
+	return this->values;
+}
+
+/**
+ * Find the value of an item.
+ * @param item The item to look for.
+ * @return The value of the item, or \c nullptr when the item is not in the list.
+ */
+SQInteger *ScriptList::FindValue(SQInteger item)
+{
+	auto it = std::lower_bound(this->items.begin(), this->items.end(), ScriptListEntry{item, 0}, ItemLess);
+	if (it != this->items.end() && it->item == item) return this->removed_items.contains(item) ? nullptr : &it->value;
+
+	auto added = this->added_items.find(item);
+	return added == this->added_items.end() ? nullptr : &added->second;
+}
+
+/**
+ * Find the first entry of a sorted vector in the walking direction, starting at an entry.
+ * @param entries The sorted entries.
+ * @param less The order of the entries.
+ * @param valid Function telling whether an entry is still in the list.
+ * @param from The entry to start from, or \c nullptr to start at the beginning.
+ * @param ascending Whether to walk ascending or descending.
+ * @param inclusive Whether \a from itself may be found.
+ * @return The found entry, or \c nullptr when there is none.
+ */
+template <class Tentries, class Tless, class Tvalid>
+static const typename Tentries::value_type *FindSortedEntry(const Tentries &entries, Tless less, Tvalid valid, const typename Tentries::value_type *from, bool ascending, bool inclusive)
+{
+	if (ascending) {
+		auto it = from == nullptr ? entries.begin() : (inclusive ? std::lower_bound(entries.begin(), entries.end(), *from, less) : std::upper_bound(entries.begin(), entries.end(), *from, less));
+		for (; it != entries.end(); ++it) {
+			if (valid(*it)) return &*it;
+		}
+	} else {
+		auto it = from == nullptr ? entries.end() : (inclusive ? std::upper_bound(entries.begin(), entries.end(), *from, less) : std::lower_bound(entries.begin(), entries.end(), *from, less));
+		while (it != entries.begin()) {
+			--it;
+			if (valid(*it)) return &*it;
+		}
+	}
+	return nullptr;
+}
+
+/**
+ * Find the first element of an ordered container in the walking direction, starting at a key.
+ * @param container The container.
+ * @param from The key to start from, or \c nullptr to start at the beginning.
+ * @param ascending Whether to walk ascending or descending.
+ * @param inclusive Whether the element with key \a from itself may be found.
+ * @return Iterator to the found element, or the end of the container when there is none.
+ */
+template <class Tcontainer, class Tkey>
+static auto FindOrderedElement(const Tcontainer &container, const Tkey *from, bool ascending, bool inclusive)
+{
+	if (ascending) {
+		if (from == nullptr) return container.begin();
+		return inclusive ? container.lower_bound(*from) : container.upper_bound(*from);
+	}
+
+	auto it = from == nullptr ? container.end() : (inclusive ? container.upper_bound(*from) : container.lower_bound(*from));
+	return it == container.begin() ? container.end() : std::prev(it);
+}
+
+/**
+ * Find the entry that comes first in the order of a sorter, starting at an entry.
+ * @param type What the list is sorted by.
+ * @param from The entry to start from, or \c nullptr to start at the beginning.
+ * @param ascending Whether to walk ascending or descending.
+ * @param inclusive Whether \a from itself may be found.
+ * @return The found entry, or \c std::nullopt when there is none.
+ */
+std::optional<ScriptList::ScriptListEntry> ScriptList::FindEntry(SorterType type, const ScriptListEntry *from, bool ascending, bool inclusive)
+{
+	/* Take the first of the entry from the vector and the entry from the changes next to it. */
+	auto first = [ascending](const ScriptListEntry *a, std::optional<ScriptListEntry> b, auto less) -> std::optional<ScriptListEntry> {
+		if (a == nullptr) return b;
+		if (!b.has_value()) return *a;
+		return less(*a, *b) == ascending ? *a : *b;
+	};
+
+	if (type == SORT_BY_ITEM) {
+		const ScriptListEntry *entry = FindSortedEntry(this->items, ItemLess, [this](const ScriptListEntry &e) { return this->removed_items.empty() || !this->removed_items.contains(e.item); }, from, ascending, inclusive);
+		auto added = FindOrderedElement(this->added_items, from == nullptr ? nullptr : &from->item, ascending, inclusive);
+		return first(entry, added == this->added_items.end() ? std::nullopt : std::optional<ScriptListEntry>{{added->first, added->second}}, ItemLess);
+	}
+
+	const ScriptListEntries &values = this->values_sorted ? this->values : this->GetValueOrder();
+	const ScriptListEntry *entry = FindSortedEntry(values, ValueLess, [this](const ScriptListEntry &e) {
+		if (this->outdated_values == 0) return true;
+		const SQInteger *value = this->FindValue(e.item);
+		return value != nullptr && *value == e.value;
+	}, from, ascending, inclusive);
+	auto added = FindOrderedElement(this->added_values, from, ascending, inclusive);
+	return first(entry, added == this->added_values.end() ? std::nullopt : std::optional<ScriptListEntry>{*added}, ValueLess);
+}
+
 bool ScriptList::HasItem(SQInteger item)
 {
-	return this->items.count(item) == 1;
+	return this->FindValue(item) != nullptr;
 }
 
 void ScriptList::Clear()
@@ -491,7 +429,12 @@ void ScriptList::Clear()
 	this->modifications++;
 
 	this->items.clear();
-	this->buckets.clear();
+	this->added_items.clear();
+	this->removed_items.clear();
+	this->values.clear();
+	this->added_values.clear();
+	this->outdated_values = 0;
+	this->values_sorted = true;
 	this->sorter->End();
 }
 
@@ -499,27 +442,34 @@ void ScriptList::AddItem(SQInteger item, SQInteger value)
 {
 	this->modifications++;
 
-	if (this->HasItem(item)) return;
+	if ((this->items.empty() || item > this->items.back().item) && (this->added_items.empty() || item > this->added_items.rbegin()->first)) {
+		/* Items are usually added in ascending order, in which case they are simply appended. */
+		this->items.push_back({item, value});
+	} else {
+		auto it = std::lower_bound(this->items.begin(), this->items.end(), ScriptListEntry{item, 0}, ItemLess);
+		if (it != this->items.end() && it->item == item) {
+			/* Adding an item that is in the list already is ignored; one that was removed is added back. */
+			if (this->removed_items.erase(item) == 0) return;
+			it->value = value;
+		} else if (!this->added_items.try_emplace(item, value).second) {
+			return;
+		}
+	}
 
-	this->items[item] = value;
-	this->buckets[value].insert(item);
+	this->ValueAdded({item, value});
+	this->MergeChanges();
 }
 
 void ScriptList::RemoveItem(SQInteger item)
 {
 	this->modifications++;
 
-	ScriptListMap::iterator item_iter = this->items.find(item);
-	if (item_iter == this->items.end()) return;
-
-	SQInteger value = item_iter->second;
+	SQInteger *value = this->FindValue(item);
+	if (value == nullptr) return;
 
-	this->sorter->Remove(item);
-	ScriptListBucket::iterator bucket_iter = this->buckets.find(value);
-	assert(bucket_iter != this->buckets.end());
-	bucket_iter->second.erase(item);
-	if (bucket_iter->second.empty()) this->buckets.erase(bucket_iter);
-	this->items.erase(item_iter);
+	this->ValueRemoved({item, *value});
+	if (this->added_items.erase(item) == 0) this->removed_items.insert(item);
+	this->MergeChanges();
 }
 
 SQInteger ScriptList::Begin()
@@ -539,7 +489,7 @@ SQInteger ScriptList::Next()
 
 bool ScriptList::IsEmpty()
 {
-	return this->items.empty();
+	return this->Count() == 0;
 }
 
 bool ScriptList::IsEnd()
@@ -553,32 +503,28 @@ bool ScriptList::IsEnd()
 
 SQInteger ScriptList::Count()
 {
-	return this->items.size();
+	return this->items.size() - this->removed_items.size() + this->added_items.size();
 }
 
 SQInteger ScriptList::GetValue(SQInteger item)
 {
-	ScriptListMap::const_iterator item_iter = this->items.find(item);
-	return item_iter == this->items.end() ? 0 : item_iter->second;
+	const SQInteger *value = this->FindValue(item);
+	return value == nullptr ? 0 : *value;
 }
 
 bool ScriptList::SetValue(SQInteger item, SQInteger value)
 {
 	this->modifications++;
 
-	ScriptListMap::iterator item_iter = this->items.find(item);
-	if (item_iter == this->items.end()) return false;
+	SQInteger *current = this->FindValue(item);
+	if (current == nullptr) return false;
 
-	SQInteger value_old = item_iter->second;
-	if (value_old == value) return true;
+	if (*current == value) return true;
 
-	this->sorter->Remove(item);
-	ScriptListBucket::iterator bucket_iter = this->buckets.find(value_old);
-	assert(bucket_iter != this->buckets.end());
-	bucket_iter->second.erase(item);
-	if (bucket_iter->second.empty()) this->buckets.erase(bucket_iter);
-	item_iter->second = value;
-	this->buckets[value].insert(item);
+	this->ValueRemoved({item, *current});
+	*current = value;
+	this->ValueAdded({item, value});
+	this->MergeChanges();
 
 	return true;
 }
@@ -590,25 +536,7 @@ void ScriptList::Sort(SorterType sorter, bool ascending)
 	if (sorter != SORT_BY_VALUE && sorter != SORT_BY_ITEM) return;
 	if (sorter == this->sorter_type && ascending == this->sort_ascending) return;
 
-	switch (sorter) {
-		case SORT_BY_ITEM:
-			if (ascending) {
-				this->sorter = std::make_unique<ScriptListSorterItemAscending>(this);
-			} else {
-				this->sorter = std::make_unique<ScriptListSorterItemDescending>(this);
-			}
-			break;
-
-		case SORT_BY_VALUE:
-			if (ascending) {
-				this->sorter = std::make_unique<ScriptListSorterValueAscending>(this);
-			} else {
-				this->sorter = std::make_unique<ScriptListSorterValueDescending>(this);
-			}
-			break;
-
-		default: NOT_REACHED();
-	}
+	this->sorter         = std::make_unique<ScriptListSorter>(this, sorter, ascending);
 	this->sorter_type    = sorter;
 	this->sort_ascending = ascending;
 	this->initialized    = false;
@@ -618,18 +546,36 @@ void ScriptList::AddList(ScriptList *list)
 {
 	if (list == this) return;
 
+	this->modifications++;
+
 	if (this->IsEmpty()) {
 		/* If this is empty, we can just take the items of the other list as is. */
 		this->items = list->items;
-		this->buckets = list->buckets;
-		this->modifications++;
-	} else {
-		ScriptListMap *list_items = &list->items;
-		for (auto &it : *list_items) {
-			this->AddItem(it.first);
-			this->SetValue(it.first, it.second);
-		}
+		this->added_items = list->added_items;
+		this->removed_items = list->removed_items;
+		this->values = list->values;
+		this->added_values = list->added_values;
+		this->outdated_values = list->outdated_values;
+		this->values_sorted = list->values_sorted;
+		return;
+	}
+
+	/* Merge both sorted lists; items in both lists get the value of the added list. */
+	const ScriptListEntries &ours = this->GetItemOrder();
+	const ScriptListEntries &theirs = list->GetItemOrder();
+	ScriptListEntries merged;
+	merged.reserve(ours.size() + theirs.size());
+
+	auto our_iter = ours.begin();
+	for (const ScriptListEntry &entry : theirs) {
+		for (; our_iter != ours.end() && our_iter->item < entry.item; ++our_iter) merged.push_back(*our_iter);
+		if (our_iter != ours.end() && our_iter->item == entry.item) ++our_iter;
+		merged.push_back(entry);
 	}
+	merged.insert(merged.end(), our_iter, ours.end());
+
+	this->items = std::move(merged);
+	this->InvalidateValueOrder();
 }
 
 void ScriptList::SwapList(ScriptList *list)
@@ -637,7 +583,12 @@ void ScriptList::SwapList(ScriptList *list)
 	if (list == this) return;
 
 	this->items.swap(list->items);
-	this->buckets.swap(list->buckets);
+	this->added_items.swap(list->added_items);
+	this->removed_items.swap(list->removed_items);
+	this->values.swap(list->values);
+	this->added_values.swap(list->added_values);
+	std::swap(this->outdated_values, list->outdated_values);
+	std::swap(this->values_sorted, list->values_sorted);
 	std::swap(this->sorter, list->sorter);
 	std::swap(this->sorter_type, list->sorter_type);
 	std::swap(this->sort_ascending, list->sort_ascending);
@@ -649,170 +600,91 @@ void ScriptList::SwapList(ScriptList *list)
 
 void ScriptList::RemoveAboveValue(SQInteger value)
 {
-	this->modifications++;
-
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second > value) this->RemoveItem((*iter).first);
-	}
+	this->RemoveItemsIf([value](SQInteger, SQInteger item_value) { return item_value > value; });
 }
 
 void ScriptList::RemoveBelowValue(SQInteger value)
 {
-	this->modifications++;
-
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second < value) this->RemoveItem((*iter).first);
-	}
+	this->RemoveItemsIf([value](SQInteger, SQInteger item_value) { return item_value < value; });
 }
 
 void ScriptList::RemoveBetweenValue(SQInteger start, SQInteger end)
 {
-	this->modifications++;
-
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second > start && (*iter).second < end) this->RemoveItem((*iter).first);
-	}
+	this->RemoveItemsIf([start, end](SQInteger, SQInteger item_value) { return item_value > start && item_value < end; });
 }
 
 void ScriptList::RemoveValue(SQInteger value)
 {
-	this->modifications++;
-
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second == value) this->RemoveItem((*iter).first);
-	}
+	this->RemoveItemsIf([value](SQInteger, SQInteger item_value) { return item_value == value; });
 }
 
-void ScriptList::RemoveTop(SQInteger count)
+/**
+ * Remove items from either end of the list, in the order of the current sorter type.
+ * @param count The amount of items to remove.
+ * @param front Whether to remove the lowest items, instead of the highest.
+ */
+void ScriptList::RemoveFromOrder(SQInteger count, bool front)
 {
 	this->modifications++;
 
-	if (!this->sort_ascending) {
-		this->Sort(this->sorter_type, !this->sort_ascending);
-		this->RemoveBottom(count);
-		this->Sort(this->sorter_type, !this->sort_ascending);
-		return;
-	}
+	if (count <= 0) return;
 
-	switch (this->sorter_type) {
-		default: NOT_REACHED();
-		case SORT_BY_VALUE:
-			for (ScriptListBucket::iterator iter = this->buckets.begin(); iter != this->buckets.end(); iter = this->buckets.begin()) {
-				ScriptItemList *items = &(*iter).second;
-				size_t size = items->size();
-				for (ScriptItemList::iterator iter = items->begin(); iter != items->end(); iter = items->begin()) {
-					if (--count < 0) return;
-					this->RemoveItem(*iter);
-					/* When the last item is removed from the bucket, the bucket itself is removed.
-					 * This means that the iterators can be invalid after a call to RemoveItem.
-					 */
-					if (--size == 0) break;
-				}
-			}
-			break;
+	const ScriptListEntries &order = this->sorter_type == SORT_BY_VALUE ? this->GetValueOrder() : this->GetItemOrder();
+	size_t amount = std::min<size_t>(count, order.size());
 
-		case SORT_BY_ITEM:
-			for (ScriptListMap::iterator iter = this->items.begin(); iter != this->items.end(); iter = this->items.begin()) {
-				if (--count < 0) return;
-				this->RemoveItem((*iter).first);
-			}
-			break;
+	std::vector<SQInteger> removed;
+	removed.reserve(amount);
+	if (front) {
+		for (auto it = order.begin(); it != order.begin() + amount; ++it) removed.push_back(it->item);
+	} else {
+		for (auto it = order.end() - amount; it != order.end(); ++it) removed.push_back(it->item);
 	}
+	std::sort(removed.begin(), removed.end());
+
+	this->RemoveItemsIf([&removed](SQInteger item, SQInteger) { return std::binary_search(removed.begin(), removed.end(), item); });
 }
 
-void ScriptList::RemoveBottom(SQInteger count)
+void ScriptList::RemoveTop(SQInteger count)
 {
-	this->modifications++;
-
-	if (!this->sort_ascending) {
-		this->Sort(this->sorter_type, !this->sort_ascending);
-		this->RemoveTop(count);
-		this->Sort(this->sorter_type, !this->sort_ascending);
-		return;
-	}
-
-	switch (this->sorter_type) {
-		default: NOT_REACHED();
-		case SORT_BY_VALUE:
-			for (ScriptListBucket::reverse_iterator iter = this->buckets.rbegin(); iter != this->buckets.rend(); iter = this->buckets.rbegin()) {
-				ScriptItemList *items = &(*iter).second;
-				size_t size = items->size();
-				for (ScriptItemList::reverse_iterator iter = items->rbegin(); iter != items->rend(); iter = items->rbegin()) {
-					if (--count < 0) return;
-					this->RemoveItem(*iter);
-					/* When the last item is removed from the bucket, the bucket itself is removed.
-					 * This means that the iterators can be invalid after a call to RemoveItem.
-					 */
-					if (--size == 0) break;
-				}
-			}
-			break;
+	this->RemoveFromOrder(count, this->sort_ascending);
+}
 
-		case SORT_BY_ITEM:
-			for (ScriptListMap::reverse_iterator iter = this->items.rbegin(); iter != this->items.rend(); iter = this->items.rbegin()) {
-				if (--count < 0) return;
-				this->RemoveItem((*iter).first);
-			}
-			break;
-	}
+void ScriptList::RemoveBottom(SQInteger count)
+{
+	this->RemoveFromOrder(count, !this->sort_ascending);
 }
 
 void ScriptList::RemoveList(ScriptList *list)
 {
-	this->modifications++;
-
 	if (list == this) {
-		Clear();
-	} else {
-		ScriptListMap *list_items = &list->items;
-		for (ScriptListMap::iterator iter = list_items->begin(); iter != list_items->end(); iter++) {
-			this->RemoveItem((*iter).first);
-		}
+		this->Clear();
+		return;
 	}
+
+	const ScriptListEntries &removed = list->GetItemOrder();
+	this->RemoveItemsIf([&removed](SQInteger item, SQInteger) {
+		return std::binary_search(removed.begin(), removed.end(), ScriptListEntry{item, 0}, ItemLess);
+	});
 }
 
 void ScriptList::KeepAboveValue(SQInteger value)
 {
-	this->modifications++;
-
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second <= value) this->RemoveItem((*iter).first);
-	}
+	this->RemoveItemsIf([value](SQInteger, SQInteger item_value) { return item_value <= value; });
 }
 
 void ScriptList::KeepBelowValue(SQInteger value)
 {
-	this->modifications++;
-
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second >= value) this->RemoveItem((*iter).first);
-	}
+	this->RemoveItemsIf([value](SQInteger, SQInteger item_value) { return item_value >= value; });
 }
 
 void ScriptList::KeepBetweenValue(SQInteger start, SQInteger end)
 {
-	this->modifications++;
-
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second <= start || (*iter).second >= end) this->RemoveItem((*iter).first);
-	}
+	this->RemoveItemsIf([start, end](SQInteger, SQInteger item_value) { return item_value <= start || item_value >= end; });
 }
 
 void ScriptList::KeepValue(SQInteger value)
 {
-	this->modifications++;
-
-	for (ScriptListMap::iterator next_iter, iter = this->items.begin(); iter != this->items.end(); iter = next_iter) {
-		next_iter = iter; next_iter++;
-		if ((*iter).second != value) this->RemoveItem((*iter).first);
-	}
+	this->RemoveItemsIf([value](SQInteger, SQInteger item_value) { return item_value != value; });
 }
 
 void ScriptList::KeepTop(SQInteger count)
@@ -833,12 +705,10 @@ void ScriptList::KeepList(ScriptList *list)
 {
 	if (list == this) return;
 
-	this->modifications++;
-
-	ScriptList tmp;
-	tmp.AddList(this);
-	tmp.RemoveList(list);
-	this->RemoveList(&tmp);
+	const ScriptListEntries &kept = list->GetItemOrder();
+	this->RemoveItemsIf([&kept](SQInteger item, SQInteger) {
+		return !std::binary_search(kept.begin(), kept.end(), ScriptListEntry{item, 0}, ItemLess);
+	});
 }
 
 SQInteger ScriptList::_get(HSQUIRRELVM vm)
@@ -848,10 +718,10 @@ SQInteger ScriptList::_get(HSQUIRRELVM vm)
 	SQInteger idx;
 	sq_getinteger(vm, 2, &idx);
 
-	ScriptListMap::const_iterator item_iter = this->items.find(idx);
-	if (item_iter == this->items.end()) return SQ_ERROR;
+	const SQInteger *value = this->FindValue(idx);
+	if (value == nullptr) return SQ_ERROR;
 
-	sq_pushinteger(vm, item_iter->second);
+	sq_pushinteger(vm, *value);
 	return 1;
 }
 
@@ -932,14 +802,18 @@ SQInteger ScriptList::Valuate(HSQUIRRELVM vm)
 	/* Push the function to call */
 	sq_push(vm, 2);
 
-	for (ScriptListMap::iterator iter = this->items.begin(); iter != this->items.end(); iter++) {
+	/* The values are written directly into the list, and sorted by value only once they are needed. */
+	this->MergeItems();
+	this->InvalidateValueOrder();
+
+	for (size_t i = 0; i < this->items.size(); i++) {
 		/* Check for changing of items. */
 		int previous_modification_count = this->modifications;
 
 		/* Push the root table as instance object, this is what squirrel does for meta-functions. */
 		sq_pushroottable(vm);
 		/* Push all arguments for the valuator function. */
-		sq_pushinteger(vm, (*iter).first);
+		sq_pushinteger(vm, this->items[i].item);
 		for (int i = 0; i < nparam - 1; i++) {
 			sq_push(vm, i + 3);
 		}
@@ -980,13 +854,17 @@ SQInteger ScriptList::Valuate(HSQUIRRELVM vm)
 			return sq_throwerror(vm, "modifying valuated list outside of valuator function");
 		}
 
-		this->SetValue((*iter).first, value);
+		this->items[i].value = value;
 
 		/* Pop the return value. */
 		sq_poptop(vm);
 
 		Squirrel::DecreaseOps(vm, 5);
 	}
+	/* The valuator might have needed the value order of this list, before all values were known. */
+	this->InvalidateValueOrder();
+	this->modifications++;
+
 	/* Pop from the squirrel stack:
 	 * 1. The root stable (as instance object).
 	 * 2. The valuator function.
@@ -36,12 +36,55 @@ public:
 	static const bool SORT_DESCENDING = false;
 
 private:
+	friend class ScriptListSorter;
+
+	/** An item in the list, together with its value. */
+	struct ScriptListEntry {
+		SQInteger item;  ///< The item.
+		SQInteger value; ///< The value of the item.
+	};
+	typedef std::vector<ScriptListEntry> ScriptListEntries; ///< Flat list of entries.
+
+	/** Order of list entries by value, and by item for entries with the same value. */
+	struct ValueOrder {
+		bool operator()(const ScriptListEntry &a, const ScriptListEntry &b) const { return ValueLess(a, b); }
+	};
+
+	/*
+	 * The entries are kept in flat vectors, which the bulk operations work on
+	 * directly. Adding, removing and changing single items only records the
+	 * change next to the vectors, so scripts doing this for every item while
+	 * walking a list do not move the vectors around every time. The changes
+	 * are merged into the vectors once there are many of them, or when a bulk
+	 * operation needs the vectors.
+	 */
+	ScriptListEntries items;      ///< The items in the list sorted by item, including the items in #removed_items.
+	std::map<SQInteger, SQInteger> added_items; ///< Items, and their values, added in front of the end of #items since it was last merged.
+	std::set<SQInteger> removed_items; ///< Items in #items that have been removed since it was last merged.
+	ScriptListEntries values;     ///< The entries sorted by value and then item, including outdated ones; only valid when #values_sorted.
+	std::set<ScriptListEntry, ValueOrder> added_values; ///< Entries not in #values, when #values_sorted.
+	size_t outdated_values;       ///< Number of entries in #values whose item has been removed or has another value now.
+	bool values_sorted;           ///< Whether #values, together with #added_values, is up to date.
+
 	std::unique_ptr<ScriptListSorter> sorter; ///< Sorting algorithm
 	SorterType sorter_type;       ///< Sorting type
 	bool sort_ascending;          ///< Whether to sort ascending or descending
 	bool initialized;             ///< Whether an iteration has been started
 	int modifications;            ///< Number of modification that has been done. To prevent changing data while valuating.
 
+	static bool ItemLess(const ScriptListEntry &a, const ScriptListEntry &b);
+	static bool ValueLess(const ScriptListEntry &a, const ScriptListEntry &b);
+	void MergeItems();
+	void MergeChanges();
+	void InvalidateValueOrder();
+	void ValueRemoved(const ScriptListEntry &entry);
+	void ValueAdded(const ScriptListEntry &entry);
+	const ScriptListEntries &GetItemOrder();
+	const ScriptListEntries &GetValueOrder();
+	SQInteger *FindValue(SQInteger item);
+	std::optional<ScriptListEntry> FindEntry(SorterType type, const ScriptListEntry *from, bool ascending, bool inclusive);
+	void RemoveFromOrder(SQInteger count, bool front);
+
 protected:
 	/* Temporary helper functions to get the raw index from either strongly and non-strongly typed pool items. */
 	template <typename T>
@@ -153,14 +196,37 @@ protected:
 	 */
 	void CopyList(const ScriptList *list);
 
-public:
-	typedef std::set<SQInteger> ScriptItemList;                   ///< The list of items inside the bucket
-	typedef std::map<SQInteger, ScriptItemList> ScriptListBucket; ///< The bucket list per value
-	typedef std::map<SQInteger, SQInteger> ScriptListMap;         ///< List per item
+	/**
+	 * Remove all items for which the predicate holds, in a single pass over the list.
+	 * @param predicate Function called with the item and its value, returning whether to remove the item.
+	 */
+	template <class Tpredicate>
+	void RemoveItemsIf(Tpredicate predicate)
+	{
+		this->modifications++;
 
-	ScriptListMap items;           ///< The items in the list
-	ScriptListBucket buckets;      ///< The items in the list, sorted by value
+		this->MergeItems();
+		if (!this->added_values.empty() || this->outdated_values != 0) this->InvalidateValueOrder();
+		auto remove = [&predicate](const ScriptListEntry &entry) { return predicate(entry.item, entry.value); };
+		std::erase_if(this->items, remove);
+		if (this->values_sorted) std::erase_if(this->values, remove);
+	}
 
+	/**
+	 * Give all items a value computed in C++, in a single pass over the list.
+	 * @param valuator Function called with the item, returning its new value.
+	 */
+	template <class Tvaluator>
+	void ValuateItems(Tvaluator valuator)
+	{
+		this->modifications++;
+
+		this->MergeItems();
+		for (ScriptListEntry &entry : this->items) entry.value = valuator(entry.item);
+		this->InvalidateValueOrder();
+	}
+
+public:
 	ScriptList();
 	~ScriptList();
 
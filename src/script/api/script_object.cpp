@@ -51,7 +51,7 @@ static ScriptStorage &GetStorage()
 }
 
 
-/* static */ ScriptInstance *ScriptObject::ActiveInstance::active = nullptr;
+/* static */ thread_local ScriptInstance *ScriptObject::ActiveInstance::active = nullptr;
 
 ScriptObject::ActiveInstance::ActiveInstance(ScriptInstance &instance) : alc_scope(instance.engine.get())
 {
@@ -234,6 +234,11 @@ ScriptObject::DisableDoCommandScope::DisableDoCommandScope()
 	return GetStorage().allow_do_command && squirrel.CanSuspend();
 }
 
+/* static */ void ScriptObject::DecreaseOps(int ops)
+{
+	Squirrel::DecreaseOps(ScriptObject::GetActiveInstance().engine->GetVM(), ops);
+}
+
 /* static */ ScriptEventQueue &ScriptObject::GetEventQueue()
 {
 	return GetStorage().event_queue;
@@ -260,6 +265,28 @@ ScriptObject::DisableDoCommandScope::DisableDoCommandScope()
 	return ScriptObject::GetActiveInstance().GetDoCommandCallback();
 }
 
+/**
+ * Queue a command of the active script, to be executed once all scripts are done.
+ * @param command The command to execute.
+ */
+/* static */ void ScriptObject::QueueDoCommand(std::function<void()> &&command)
+{
+	ScriptObject::GetActiveInstance().QueueDoCommand(std::move(command));
+}
+
+/**
+ * Hand the result of a queued command to the active script, and let it continue.
+ * @param result The result of the command.
+ * @param data The data of the command.
+ * @param result_data Additional returned data from the command.
+ * @param cmd The executed command.
+ */
+/* static */ void ScriptObject::DoCommandQueuedResult(const CommandCost &result, const CommandDataBuffer &data, CommandDataBuffer result_data, Commands cmd)
+{
+	ScriptInstance &instance = ScriptObject::GetActiveInstance();
+	if (instance.DoCommandCallback(result, data, std::move(result_data), cmd)) instance.Continue();
+}
+
 /* static */ std::tuple<bool, bool, bool, bool> ScriptObject::DoCommandPrep()
 {
 	if (!ScriptObject::CanSuspend()) {
@@ -320,7 +347,7 @@ ScriptObject::DisableDoCommandScope::DisableDoCommandScope()
 			throw SQInteger(1);
 		}
 		return true;
-	} else if (_networking) {
+	} else if (_networking || IsScriptWorkerThread()) {
 		/* Suspend the script till the command is really executed. */
 		throw Script_Suspend(-(int)GetDoCommandDelay(), callback);
 	} else {
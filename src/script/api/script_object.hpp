@@ -20,6 +20,7 @@
 #include "script_log_types.hpp"
 #include "../script_suspend.hpp"
 #include "../squirrel.hpp"
+#include "../script_thread.hpp"
 
 #include <utility>
 
@@ -81,7 +82,7 @@ protected:
 		ScriptInstance *last_active;    ///< The active instance before we go instantiated.
 		ScriptAllocatorScope alc_scope; ///< Keep the correct allocator for the script instance activated
 
-		static ScriptInstance *active;  ///< The global current active instance.
+		static thread_local ScriptInstance *active; ///< The current active instance of this thread.
 	};
 
 	class DisableDoCommandScope : private AutoRestoreBackup<bool> {
@@ -176,6 +177,7 @@ protected:
 
 	private:
 		static bool Execute(Script_SuspendCallbackProc *callback, std::tuple<Targs...> args);
+		static void Queue(TileIndex tile, std::tuple<Targs...> args, bool asynchronous, bool networking);
 	};
 
 	template <Commands Tcmd>
@@ -332,6 +334,12 @@ protected:
 	 */
 	static bool CanSuspend();
 
+	/**
+	 * Charge the script for work done on its behalf, as if it executed this many operations.
+	 * @param ops The number of operations to charge.
+	 */
+	static void DecreaseOps(int ops);
+
 	/**
 	 * Get the reference to the event queue.
 	 */
@@ -347,6 +355,8 @@ private:
 	static std::tuple<bool, bool, bool, bool> DoCommandPrep();
 	static bool DoCommandProcessResult(const CommandCost &res, Script_SuspendCallbackProc *callback, bool estimate_only, bool asynchronous);
 	static CommandCallbackData *GetDoCommandCallback();
+	static void QueueDoCommand(std::function<void()> &&command);
+	static void DoCommandQueuedResult(const CommandCost &result, const CommandDataBuffer &data, CommandDataBuffer result_data, Commands cmd);
 	using RandomizerArray = TypedIndexContainer<std::array<Randomizer, OWNER_END.base()>, Owner>;
 	static RandomizerArray random_states; ///< Random states for each of the scripts (game script uses OWNER_DEITY)
 };
@@ -415,20 +425,49 @@ bool ScriptObject::ScriptDoCommandHelper<Tcmd, Tret(*)(DoCommandFlags, Targs...)
 	/* Only set ClientID parameters when the command does not come from the network. */
 	if constexpr (::GetCommandFlags<Tcmd>().Test(CommandFlag::ClientID)) ScriptObjectInternal::SetClientIds(args, std::index_sequence_for<Targs...>{});
 
+	/* Scripts running on a worker thread only test the command; it is executed once all scripts are done. */
+	bool queued = !estimate_only && IsScriptWorkerThread();
+
 	/* Store the command for command callback validation. */
-	if (!estimate_only && networking) ScriptObject::SetLastCommand(EndianBufferWriter<CommandDataBuffer>::FromValue(args), Tcmd);
+	if (!estimate_only && (networking || queued)) ScriptObject::SetLastCommand(EndianBufferWriter<CommandDataBuffer>::FromValue(args), Tcmd);
 
 	/* Try to perform the command. */
-	Tret res = ::Command<Tcmd>::Unsafe((StringID)0, (!asynchronous && networking) ? ScriptObject::GetDoCommandCallback() : nullptr, false, estimate_only, tile, args);
+	Tret res = ::Command<Tcmd>::Unsafe((StringID)0, (!asynchronous && networking && !queued) ? ScriptObject::GetDoCommandCallback() : nullptr, false, estimate_only || queued, tile, args);
 
 	if constexpr (std::is_same_v<Tret, CommandCost>) {
+		if (queued && res.Succeeded()) Queue(tile, args, asynchronous, networking);
 		return ScriptObject::DoCommandProcessResult(res, callback, estimate_only, asynchronous);
 	} else {
+		if (queued && std::get<0>(res).Succeeded()) Queue(tile, args, asynchronous, networking);
 		ScriptObject::SetLastCommandResData(EndianBufferWriter<CommandDataBuffer>::FromValue(ScriptObjectInternal::RemoveFirstTupleElement(res)));
 		return ScriptObject::DoCommandProcessResult(std::get<0>(res), callback, estimate_only, asynchronous);
 	}
 }
 
+/**
+ * Queue a command of a script running on a worker thread, to be executed once all scripts are done.
+ * Without networking the result is handed to the script like the command callback does with networking.
+ * @param tile The tile the command is executed on.
+ * @param args The arguments of the command.
+ * @param asynchronous Whether the script does not wait for the result.
+ * @param networking Whether the command has to be sent over the network.
+ */
+template <Commands Tcmd, typename Tret, typename... Targs>
+void ScriptObject::ScriptDoCommandHelper<Tcmd, Tret(*)(DoCommandFlags, Targs...)>::Queue(TileIndex tile, std::tuple<Targs...> args, bool asynchronous, bool networking)
+{
+	ScriptObject::QueueDoCommand([company = _current_company, tile, args = std::move(args), asynchronous, networking]() {
+		_current_company = company;
+		Tret res = ::Command<Tcmd>::Unsafe((StringID)0, (!asynchronous && networking) ? ScriptObject::GetDoCommandCallback() : nullptr, false, false, tile, args);
+		if (asynchronous || networking) return;
+
+		if constexpr (std::is_same_v<Tret, CommandCost>) {
+			ScriptObject::DoCommandQueuedResult(res, EndianBufferWriter<CommandDataBuffer>::FromValue(args), {}, Tcmd);
+		} else {
+			ScriptObject::DoCommandQueuedResult(std::get<0>(res), EndianBufferWriter<CommandDataBuffer>::FromValue(args), EndianBufferWriter<CommandDataBuffer>::FromValue(ScriptObjectInternal::RemoveFirstTupleElement(res)), Tcmd);
+		}
+	});
+}
+
 /**
  * Internally used class to automate the ScriptObject reference counting.
  * @api -all
@@ -0,0 +1,253 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file script_roadpathfinder.cpp Implementation of ScriptRoadPathFinder. */
+
+#include "../../stdafx.h"
+#include "script_roadpathfinder.hpp"
+#include "script_error.hpp"
+#include "script_road.hpp"
+#include "script_tile.hpp"
+#include "../squirrel.hpp"
+#include "../script_instance.hpp"
+#include "../../pathfinder/aystar.h"
+#include "../../tunnelbridge_map.h"
+
+#include "../../safeguards.h"
+
+/** Upper limit of the maximum cost of a route, so costs of routes always fit in the search nodes. */
+static const SQInteger MAX_ROUTE_COST = INT32_MAX / 2;
+
+/**
+ * The search of a ScriptRoadPathFinder. It follows the rules of the road
+ * pathfinder library scripts use, so it finds the same kind of routes.
+ */
+class RoadPathSearch : public AyStar {
+public:
+	using Costs = std::array<SQInteger, ScriptRoadPathFinder::COST_MAX + 1>; ///< The costs to rate a route with.
+
+	std::vector<TileIndex> path; ///< The found route, from the goal back to the source.
+	SQInteger path_cost = -1;    ///< The cost of the found route.
+	mutable int examined = 0;    ///< The number of tiles examined so far.
+
+	/**
+	 * Create a search.
+	 * @param costs The costs to rate a route with.
+	 * @param max_search_nodes The maximum number of tiles to examine.
+	 * @param goals The tiles where the route may end.
+	 */
+	RoadPathSearch(const Costs &costs, int max_search_nodes, std::vector<TileIndex> &&goals) : costs(costs), goals(std::move(goals))
+	{
+		this->max_search_nodes = max_search_nodes;
+		std::sort(this->goals.begin(), this->goals.end());
+	}
+
+	/**
+	 * Add a tile where the route may start.
+	 * @param tile The tile.
+	 */
+	void AddSource(TileIndex tile)
+	{
+		AyStarNode start;
+		start.tile = tile;
+		start.td = INVALID_TRACKDIR;
+		this->AddStartNode(&start, 0);
+	}
+
+	/**
+	 * Continue the search.
+	 * @param iterations The maximum number of tiles to examine.
+	 * @return The state of the search.
+	 */
+	AyStarStatus Run(int iterations)
+	{
+		return this->Main(iterations);
+	}
+
+protected:
+	/**
+	 * Check whether a road going through a tile goes up or down its slope.
+	 * @param tile The tile.
+	 * @param dir The direction the road goes through the tile.
+	 * @return True iff the road is sloped.
+	 */
+	static bool IsSlopedRoad(TileIndex tile, DiagDirection dir)
+	{
+		Slope slope = ::GetTileSlope(tile);
+		return IsInclinedSlope(slope) && DiagDirToAxis(GetInclinedSlopeDirection(slope)) == DiagDirToAxis(dir);
+	}
+
+	int32_t CalculateG(const AyStarNode &current, const PathNode &parent) const override
+	{
+		TileIndex prev_tile = parent.GetTile();
+		uint distance = DistanceManhattan(prev_tile, current.tile);
+
+		SQInteger cost = this->costs[ScriptRoadPathFinder::COST_TILE] * distance;
+		if (distance == 1) {
+			if (!ScriptRoad::AreRoadTilesConnected(prev_tile, current.tile)) cost += this->costs[ScriptRoadPathFinder::COST_NO_EXISTING_ROAD];
+			if (ScriptTile::IsCoastTile(current.tile)) cost += this->costs[ScriptRoadPathFinder::COST_COAST];
+
+			if (parent.key.td != INVALID_TRACKDIR) {
+				DiagDirection prev_dir = TrackdirToExitdir(parent.key.td);
+				if (prev_dir != TrackdirToExitdir(current.td)) cost += this->costs[ScriptRoadPathFinder::COST_TURN];
+				/* A road through the previous tile, except the end of a bridge or tunnel, that goes up or down its slope. */
+				if (!IsTileType(prev_tile, MP_TUNNELBRIDGE) && prev_dir == TrackdirToExitdir(current.td) && IsSlopedRoad(prev_tile, prev_dir)) {
+					cost += this->costs[ScriptRoadPathFinder::COST_SLOPE];
+				}
+			}
+		}
+
+		if (parent.cost + cost > this->costs[ScriptRoadPathFinder::COST_MAX]) return AYSTAR_INVALID_NODE;
+		return static_cast<int32_t>(cost);
+	}
+
+	int32_t CalculateH(const AyStarNode &current, const PathNode &) const override
+	{
+		uint distance = UINT_MAX;
+		for (TileIndex goal : this->goals) distance = std::min(distance, DistanceManhattan(current.tile, goal));
+		return static_cast<int32_t>(std::min<SQInteger>(distance * this->costs[ScriptRoadPathFinder::COST_TILE], MAX_ROUTE_COST));
+	}
+
+	void GetNeighbours(const PathNode &current, std::vector<AyStarNode> &neighbours) const override
+	{
+		TileIndex tile = current.GetTile();
+		neighbours.clear();
+		this->examined++;
+
+		/* When entering an existing road bridge or tunnel, the only way is to its other end. */
+		if (IsTileType(tile, MP_TUNNELBRIDGE) && GetTunnelBridgeTransportType(tile) == TRANSPORT_ROAD &&
+				current.key.td != INVALID_TRACKDIR && TrackdirToExitdir(current.key.td) == GetTunnelBridgeDirection(tile)) {
+			auto &neighbour = neighbours.emplace_back();
+			neighbour.tile = GetOtherTunnelBridgeEnd(tile);
+			neighbour.td = current.key.td;
+			return;
+		}
+
+		TileIndex prev_tile = current.parent != nullptr ? current.parent->GetTile() : INVALID_TILE;
+		for (DiagDirection d = DIAGDIR_BEGIN; d < DIAGDIR_END; d++) {
+			TileIndex next = tile + TileOffsByDiagDir(d);
+			if (!IsValidTile(next) || next == prev_tile) continue;
+
+			/* Either the tiles are connected by road already, or a road can be built between them. */
+			if (!ScriptRoad::AreRoadTilesConnected(tile, next)) {
+				if (!ScriptTile::IsBuildable(next) && !ScriptRoad::IsRoadTile(next)) continue;
+				if (prev_tile != INVALID_TILE && ScriptRoad::CanBuildConnectedRoadPartsHere(tile, prev_tile, next) <= 0) continue;
+				if (ScriptRoad::CanBuildConnectedRoadPartsHere(next, tile, next + TileOffsByDiagDir(d)) <= 0) continue;
+			}
+
+			auto &neighbour = neighbours.emplace_back();
+			neighbour.tile = next;
+			neighbour.td = DiagDirToDiagTrackdir(d);
+		}
+	}
+
+	AyStarStatus EndNodeCheck(const PathNode &current) const override
+	{
+		return std::binary_search(this->goals.begin(), this->goals.end(), current.GetTile()) ? AyStarStatus::FoundEndNode : AyStarStatus::Done;
+	}
+
+	void FoundEndNode(const PathNode &current) override
+	{
+		this->path.clear();
+		for (const PathNode *node = &current; node != nullptr; node = node->parent) {
+			this->path.push_back(node->GetTile());
+		}
+		this->path_cost = current.cost;
+	}
+
+private:
+	Costs costs;                 ///< The costs to rate a route with.
+	std::vector<TileIndex> goals; ///< The tiles where the route may end, sorted.
+};
+
+ScriptRoadPathFinder::ScriptRoadPathFinder() :
+	costs({100, 40, 100, 200, 20, 10000000}), // The defaults of the road pathfinder library.
+	max_search_nodes(AYSTAR_DEF_MAX_SEARCH_NODES * 10),
+	status(SEARCH_NOT_FOUND)
+{
+}
+
+ScriptRoadPathFinder::~ScriptRoadPathFinder()
+{
+}
+
+void ScriptRoadPathFinder::SetCost(CostType type, SQInteger cost)
+{
+	if (type < COST_TILE || type > COST_MAX || cost < 0) return;
+
+	this->costs[type] = std::min(cost, MAX_ROUTE_COST);
+}
+
+SQInteger ScriptRoadPathFinder::GetCost(CostType type)
+{
+	if (type < COST_TILE || type > COST_MAX) return -1;
+
+	return this->costs[type];
+}
+
+void ScriptRoadPathFinder::SetMaxSearchNodes(SQInteger max_nodes)
+{
+	if (max_nodes <= 0) return;
+
+	this->max_search_nodes = std::min<SQInteger>(max_nodes, INT32_MAX);
+}
+
+bool ScriptRoadPathFinder::InitializePath(ScriptTileList *sources, ScriptTileList *goals)
+{
+	EnforcePrecondition(false, sources != nullptr);
+	EnforcePrecondition(false, goals != nullptr);
+	EnforcePrecondition(false, ScriptRoad::IsRoadTypeAvailable(ScriptRoad::GetCurrentRoadType()));
+
+	std::vector<TileIndex> goal_tiles;
+	for (SQInteger tile = goals->Begin(); !goals->IsEnd(); tile = goals->Next()) {
+		if (::IsValidTile(TileIndex(tile))) goal_tiles.push_back(TileIndex(tile));
+	}
+
+	this->search = std::make_unique<RoadPathSearch>(this->costs, static_cast<int>(this->max_search_nodes), std::move(goal_tiles));
+	for (SQInteger tile = sources->Begin(); !sources->IsEnd(); tile = sources->Next()) {
+		if (::IsValidTile(TileIndex(tile))) this->search->AddSource(TileIndex(tile));
+	}
+	this->status = SEARCH_BUSY;
+	return true;
+}
+
+ScriptRoadPathFinder::SearchStatus ScriptRoadPathFinder::FindPath(SQInteger iterations)
+{
+	EnforcePrecondition(this->status, iterations > 0);
+	if (this->status != SEARCH_BUSY) return this->status;
+
+	int examined = this->search->examined;
+	switch (this->search->Run(static_cast<int>(std::min<SQInteger>(iterations, INT32_MAX)))) {
+		case AyStarStatus::FoundEndNode: this->status = SEARCH_FOUND; break;
+		case AyStarStatus::NoPath: this->status = SEARCH_NOT_FOUND; break;
+		default: break;
+	}
+
+	/* Charge the script for the tiles examined. */
+	ScriptObject::DecreaseOps(this->search->examined - examined);
+
+	return this->status;
+}
+
+ScriptTileList *ScriptRoadPathFinder::GetPath()
+{
+	if (this->status != SEARCH_FOUND) return nullptr;
+
+	ScriptTileList *list = new ScriptTileList();
+	SQInteger position = 0;
+	for (auto it = this->search->path.rbegin(); it != this->search->path.rend(); ++it) {
+		list->AddItem(it->base(), position++);
+	}
+	return list;
+}
+
+SQInteger ScriptRoadPathFinder::GetPathCost()
+{
+	if (this->status != SEARCH_FOUND) return -1;
+
+	return this->search->path_cost;
+}
@@ -0,0 +1,117 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file script_roadpathfinder.hpp Find a route for a road between tiles. */
+
+#ifndef SCRIPT_ROADPATHFINDER_HPP
+#define SCRIPT_ROADPATHFINDER_HPP
+
+#include "script_tilelist.hpp"
+
+class RoadPathSearch;
+
+/**
+ * Class that finds a route for a road between tiles. The route uses existing
+ *  roads and tiles where a road of the current road type can be built, and
+ *  existing road bridges and tunnels. It does not plan new bridges or tunnels.
+ * The search runs in the game itself, which makes it a lot cheaper than a
+ *  pathfinder written in Squirrel. It can be spread over several calls, so the
+ *  script stays responsive while searching a long route.
+ * @note Every node the search handles costs the script one operation.
+ * @api ai game
+ */
+class ScriptRoadPathFinder : public ScriptObject {
+public:
+	/**
+	 * The costs the pathfinder uses to rate a route.
+	 */
+	enum CostType {
+		COST_TILE,             ///< The cost of every tile of the route.
+		COST_NO_EXISTING_ROAD, ///< The extra cost of a tile that is not connected by road yet.
+		COST_TURN,             ///< The extra cost of a turn.
+		COST_SLOPE,            ///< The extra cost of a road going up or down a slope.
+		COST_COAST,            ///< The extra cost of a coast tile.
+		COST_MAX,              ///< The maximum cost of a route; more expensive routes are not considered.
+	};
+
+	/**
+	 * The state of a search.
+	 */
+	enum SearchStatus {
+		SEARCH_BUSY,      ///< The search is not done yet; call FindPath again to continue it.
+		SEARCH_FOUND,     ///< A route has been found.
+		SEARCH_NOT_FOUND, ///< There is no route, or the search limit has been reached.
+	};
+
+	ScriptRoadPathFinder();
+	~ScriptRoadPathFinder();
+
+	/**
+	 * Set one of the costs used to rate a route.
+	 * @param type The cost to set.
+	 * @param cost The new cost.
+	 * @pre cost >= 0.
+	 * @note Changes only apply to searches that are started afterwards.
+	 */
+	void SetCost(CostType type, SQInteger cost);
+
+	/**
+	 * Get one of the costs used to rate a route.
+	 * @param type The cost to get.
+	 * @return The cost.
+	 */
+	SQInteger GetCost(CostType type);
+
+	/**
+	 * Set the maximum number of tiles a search may examine before it gives up.
+	 * @param max_nodes The maximum number of tiles.
+	 * @pre max_nodes > 0.
+	 * @note Changes only apply to searches that are started afterwards.
+	 */
+	void SetMaxSearchNodes(SQInteger max_nodes);
+
+	/**
+	 * Start a new search for a route from any of the sources to any of the goals.
+	 * @param sources The tiles where the route may start.
+	 * @param goals The tiles where the route may end.
+	 * @pre sources != null && goals != null.
+	 * @pre ScriptRoad::IsRoadTypeAvailable(ScriptRoad::GetCurrentRoadType()).
+	 * @return True if the search has been started.
+	 */
+	bool InitializePath(ScriptTileList *sources, ScriptTileList *goals);
+
+	/**
+	 * Continue the search for a route.
+	 * @param iterations The maximum number of tiles to examine in this call.
+	 * @pre iterations > 0.
+	 * @return The state of the search. It is SEARCH_NOT_FOUND when no search has been started.
+	 */
+	SearchStatus FindPath(SQInteger iterations);
+
+	/**
+	 * Get the route that has been found.
+	 * @pre FindPath() returned SEARCH_FOUND.
+	 * @return The tiles of the route, with as value their position along the route, starting at 0 for the source.
+	 *  Sort the list by value to walk the route. Tiles more than one tile apart are the ends of a bridge or tunnel.
+	 */
+	ScriptTileList *GetPath();
+
+	/**
+	 * Get the cost of the route that has been found.
+	 * @pre FindPath() returned SEARCH_FOUND.
+	 * @return The cost of the route, or -1 when no route has been found.
+	 */
+	SQInteger GetPathCost();
+
+private:
+	std::array<SQInteger, COST_MAX + 1> costs; ///< The costs to rate a route with.
+	SQInteger max_search_nodes;                ///< The maximum number of tiles a search may examine.
+	std::unique_ptr<RoadPathSearch> search;    ///< The running or finished search, if any.
+	SearchStatus status;                       ///< The state of the search.
+};
+
+#endif /* SCRIPT_ROADPATHFINDER_HPP */
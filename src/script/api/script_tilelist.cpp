@@ -10,6 +10,7 @@
 #include "../../stdafx.h"
 #include "script_tilelist.hpp"
 #include "script_industry.hpp"
+#include "script_tile.hpp"
 #include "../../industry.h"
 #include "../../station_base.h"
 
@@ -52,7 +53,9 @@ void ScriptTileList::RemoveRectangle(TileIndex t1, TileIndex t2)
 	if (!::IsValidTile(t2)) return;
 
 	TileArea ta(t1, t2);
-	for (TileIndex t : ta) this->RemoveItem(t.base());
+	this->RemoveItemsIf([&ta](SQInteger item, SQInteger) {
+		return item >= 0 && item < static_cast<SQInteger>(Map::Size()) && ta.Contains(TileIndex(static_cast<uint32_t>(item)));
+	});
 }
 
 void ScriptTileList::RemoveTile(TileIndex tile)
@@ -62,6 +65,51 @@ void ScriptTileList::RemoveTile(TileIndex tile)
 	this->RemoveItem(tile.base());
 }
 
+/**
+ * Get the tile of an item in the list, the same way Squirrel converts the item when passing it to a valuator.
+ * @param item The item in the list.
+ * @return The tile.
+ */
+static TileIndex GetItemTile(SQInteger item)
+{
+	return TileIndex(static_cast<uint32_t>(static_cast<int32_t>(item)));
+}
+
+void ScriptTileList::ValuateBuildable()
+{
+	this->ValuateItems([](SQInteger item) -> SQInteger { return ScriptTile::IsBuildable(GetItemTile(item)) ? 1 : 0; });
+}
+
+void ScriptTileList::ValuateSlope()
+{
+	this->ValuateItems([](SQInteger item) -> SQInteger { return ScriptTile::GetSlope(GetItemTile(item)); });
+}
+
+void ScriptTileList::ValuateMinHeight()
+{
+	this->ValuateItems([](SQInteger item) -> SQInteger { return ScriptTile::GetMinHeight(GetItemTile(item)); });
+}
+
+void ScriptTileList::ValuateMaxHeight()
+{
+	this->ValuateItems([](SQInteger item) -> SQInteger { return ScriptTile::GetMaxHeight(GetItemTile(item)); });
+}
+
+void ScriptTileList::ValuateOwner()
+{
+	this->ValuateItems([](SQInteger item) -> SQInteger { return ScriptTile::GetOwner(GetItemTile(item)); });
+}
+
+void ScriptTileList::ValuateDistanceManhattanToTile(TileIndex tile)
+{
+	this->ValuateItems([tile](SQInteger item) -> SQInteger { return ScriptTile::GetDistanceManhattanToTile(GetItemTile(item), tile); });
+}
+
+void ScriptTileList::ValuateDistanceSquareToTile(TileIndex tile)
+{
+	this->ValuateItems([tile](SQInteger item) -> SQInteger { return ScriptTile::GetDistanceSquareToTile(GetItemTile(item), tile); });
+}
+
 /**
  * Helper to get list of tiles that will cover an industry's production or acceptance.
  * @param i Industry in question
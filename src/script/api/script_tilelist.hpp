@@ -55,6 +55,57 @@ public:
 	 * @pre ScriptMap::IsValidTile(tile).
 	 */
 	void RemoveTile(TileIndex tile);
+
+	/**
+	 * Give all tiles in the list a value of 1 when they are buildable, and 0 otherwise.
+	 * @note Gives the same values as Valuate(ScriptTile.IsBuildable), without calling the valuator for each tile.
+	 * @see ScriptTile::IsBuildable
+	 */
+	void ValuateBuildable();
+
+	/**
+	 * Give all tiles in the list their slope as value.
+	 * @note Gives the same values as Valuate(ScriptTile.GetSlope), without calling the valuator for each tile.
+	 * @see ScriptTile::GetSlope
+	 */
+	void ValuateSlope();
+
+	/**
+	 * Give all tiles in the list the height of their lowest corner as value.
+	 * @note Gives the same values as Valuate(ScriptTile.GetMinHeight), without calling the valuator for each tile.
+	 * @see ScriptTile::GetMinHeight
+	 */
+	void ValuateMinHeight();
+
+	/**
+	 * Give all tiles in the list the height of their highest corner as value.
+	 * @note Gives the same values as Valuate(ScriptTile.GetMaxHeight), without calling the valuator for each tile.
+	 * @see ScriptTile::GetMaxHeight
+	 */
+	void ValuateMaxHeight();
+
+	/**
+	 * Give all tiles in the list their owner as value.
+	 * @note Gives the same values as Valuate(ScriptTile.GetOwner), without calling the valuator for each tile.
+	 * @see ScriptTile::GetOwner
+	 */
+	void ValuateOwner();
+
+	/**
+	 * Give all tiles in the list their manhattan distance to a tile as value.
+	 * @param tile The tile to get the distance to.
+	 * @note Gives the same values as Valuate(ScriptTile.GetDistanceManhattanToTile, tile), without calling the valuator for each tile.
+	 * @see ScriptTile::GetDistanceManhattanToTile
+	 */
+	void ValuateDistanceManhattanToTile(TileIndex tile);
+
+	/**
+	 * Give all tiles in the list their squared distance to a tile as value.
+	 * @param tile The tile to get the distance to.
+	 * @note Gives the same values as Valuate(ScriptTile.GetDistanceSquareToTile, tile), without calling the valuator for each tile.
+	 * @see ScriptTile::GetDistanceSquareToTile
+	 */
+	void ValuateDistanceSquareToTile(TileIndex tile);
 };
 
 /**
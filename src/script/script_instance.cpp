@@ -18,6 +18,7 @@
 #include "script_storage.hpp"
 #include "script_info.hpp"
 #include "script_instance.hpp"
+#include "script_thread.hpp"
 
 #include "api/script_controller.hpp"
 #include "api/script_error.hpp"
@@ -239,7 +240,12 @@ void ScriptInstance::GameLoop()
 				}
 			}
 			/* Start the script by calling Start() */
-			if (!this->engine->CallMethod(*this->instance, "Start",  _settings_game.script.script_max_opcode_till_suspend) || !this->engine->IsSuspended()) this->Died();
+			bool started;
+			{
+				ScriptVMScope vm_scope;
+				started = this->engine->CallMethod(*this->instance, "Start",  _settings_game.script.script_max_opcode_till_suspend);
+			}
+			if (!started || !this->engine->IsSuspended()) this->Died();
 		} catch (Script_Suspend &e) {
 			this->suspend  = e.GetSuspendTime();
 			this->callback = e.GetSuspendCallback();
@@ -260,7 +266,12 @@ void ScriptInstance::GameLoop()
 
 	/* Continue the VM */
 	try {
-		if (!this->engine->Resume(_settings_game.script.script_max_opcode_till_suspend)) this->Died();
+		bool resumed;
+		{
+			ScriptVMScope vm_scope;
+			resumed = this->engine->Resume(_settings_game.script.script_max_opcode_till_suspend);
+		}
+		if (!resumed) this->Died();
 	} catch (Script_Suspend &e) {
 		this->suspend  = e.GetSuspendTime();
 		this->callback = e.GetSuspendCallback();
@@ -272,6 +283,22 @@ void ScriptInstance::GameLoop()
 	}
 }
 
+void ScriptInstance::QueueDoCommand(std::function<void()> &&command)
+{
+	this->queued_commands.push_back(std::move(command));
+}
+
+void ScriptInstance::ExecuteQueuedCommands()
+{
+	if (this->IsDead()) {
+		this->queued_commands.clear();
+		return;
+	}
+
+	ScriptObject::ActiveInstance active(*this);
+	for (auto &command : std::exchange(this->queued_commands, {})) command();
+}
+
 void ScriptInstance::CollectGarbage()
 {
 	if (this->is_started && !this->IsDead()) {
@@ -847,6 +874,12 @@ size_t ScriptInstance::GetAllocatedMemory() const
 	return this->engine->GetAllocatedMemory();
 }
 
+std::optional<ScriptMemoryStatistics> ScriptInstance::GetMemoryStatistics() const
+{
+	if (this->engine == nullptr) return std::nullopt;
+	return this->engine->GetMemoryStatistics();
+}
+
 void ScriptInstance::ReleaseSQObject(HSQOBJECT *obj)
 {
 	if (!this->in_shutdown) this->engine->ReleaseObject(obj);
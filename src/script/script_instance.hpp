@@ -21,6 +21,8 @@
 
 static const uint SQUIRREL_MAX_DEPTH = 25; ///< The maximum recursive depth for items stored in the savegame.
 
+struct ScriptMemoryStatistics;
+
 /** Runtime information about a script like a pointer to the squirrel vm and the current state. */
 class ScriptInstance {
 private:
@@ -88,6 +90,18 @@ public:
 	 */
 	void CollectGarbage();
 
+	/**
+	 * Queue a command of this script, to be executed by #ExecuteQueuedCommands.
+	 * Used for scripts running on a worker thread, which may not change the game state.
+	 * @param command The command to execute.
+	 */
+	void QueueDoCommand(std::function<void()> &&command);
+
+	/**
+	 * Execute the commands this script queued while running on a worker thread.
+	 */
+	void ExecuteQueuedCommands();
+
 	/**
 	 * Get the storage of this script.
 	 */
@@ -244,6 +258,12 @@ public:
 
 	size_t GetAllocatedMemory() const;
 
+	/**
+	 * Get statistics about the memory use and garbage collection of the script.
+	 * @return The statistics, or std::nullopt when the script is not running anymore.
+	 */
+	std::optional<ScriptMemoryStatistics> GetMemoryStatistics() const;
+
 	/**
 	 * Indicate whether this instance is currently being destroyed.
 	 */
@@ -298,6 +318,7 @@ private:
 	int suspend = 0; ///< The amount of ticks to suspend this script before it's allowed to continue.
 	bool is_paused = false; ///< Is the script paused? (a paused script will not be executed until unpaused)
 	bool in_shutdown = false; ///< Is this instance currently being destructed?
+	std::vector<std::function<void()>> queued_commands; ///< Commands queued while running on a worker thread.
 	Script_SuspendCallbackProc *callback = nullptr; ///< Callback that should be called in the next tick the script runs.
 	size_t last_allocated_memory = 0; ///< Last known allocated memory value (for display for crashed scripts)
 
@@ -0,0 +1,87 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file script_thread.cpp Implementation of running scripts on worker threads. */
+
+#include "../stdafx.h"
+#include "../company_func.h"
+#include "script_thread.hpp"
+
+#include <mutex>
+
+#include "../safeguards.h"
+
+static std::mutex _script_game_state_mutex; ///< Held by the worker thread that currently has access to the game state.
+static thread_local bool _script_worker = false; ///< Whether the current thread runs scripts in parallel with other threads.
+static thread_local uint _script_game_state_depth = 0; ///< Number of active game state scopes of the current worker thread.
+static thread_local CompanyID _script_worker_company = COMPANY_SPECTATOR; ///< The current company of the worker thread while it has no access to the game state.
+
+/** Get access to the game state for the current worker thread. */
+static void LockScriptGameState()
+{
+	_script_game_state_mutex.lock();
+	_current_company = _script_worker_company;
+}
+
+/** Give up access to the game state for the current worker thread. */
+static void UnlockScriptGameState()
+{
+	_script_worker_company = _current_company;
+	_script_game_state_mutex.unlock();
+}
+
+ScriptWorkerScope::ScriptWorkerScope()
+{
+	assert(!_script_worker);
+	_script_worker = true;
+	_script_game_state_depth = 1;
+	LockScriptGameState();
+}
+
+ScriptWorkerScope::~ScriptWorkerScope()
+{
+	assert(_script_game_state_depth == 1);
+	UnlockScriptGameState();
+	_script_game_state_depth = 0;
+	_script_worker = false;
+}
+
+ScriptGameStateScope::ScriptGameStateScope()
+{
+	if (_script_worker && _script_game_state_depth++ == 0) LockScriptGameState();
+}
+
+ScriptGameStateScope::~ScriptGameStateScope()
+{
+	if (_script_worker && --_script_game_state_depth == 0) UnlockScriptGameState();
+}
+
+ScriptVMScope::ScriptVMScope() : depth(_script_game_state_depth)
+{
+	if (this->depth == 0) return;
+
+	_script_game_state_depth = 0;
+	UnlockScriptGameState();
+}
+
+ScriptVMScope::~ScriptVMScope()
+{
+	if (this->depth == 0) return;
+
+	LockScriptGameState();
+	_script_game_state_depth = this->depth;
+}
+
+/**
+ * Check whether the current thread runs scripts in parallel with other threads.
+ * Commands of such scripts are queued, and executed once all scripts are done.
+ * @return True iff the current thread is a script worker thread.
+ */
+bool IsScriptWorkerThread()
+{
+	return _script_worker;
+}
@@ -0,0 +1,49 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file script_thread.hpp Running scripts on worker threads. */
+
+#ifndef SCRIPT_THREAD_HPP
+#define SCRIPT_THREAD_HPP
+
+/**
+ * Runs scripts on the current thread in parallel with scripts on other threads.
+ * Only one of these threads at a time has access to the game state; the others can
+ * only run the bytecode of their own script. Access to the game state is handed over
+ * whenever a script calls into the API or leaves its virtual machine.
+ */
+class ScriptWorkerScope {
+public:
+	ScriptWorkerScope();
+	~ScriptWorkerScope();
+};
+
+/**
+ * Scope in which a script may access the game state.
+ * On threads without a #ScriptWorkerScope this does nothing.
+ */
+class ScriptGameStateScope {
+public:
+	ScriptGameStateScope();
+	~ScriptGameStateScope();
+};
+
+/**
+ * Scope in which a script only runs the bytecode of its own virtual machine,
+ * so scripts on other worker threads may access the game state meanwhile.
+ * On threads without a #ScriptWorkerScope this does nothing.
+ */
+class ScriptVMScope {
+	uint depth; ///< Number of game state scopes that were active when entering this scope.
+public:
+	ScriptVMScope();
+	~ScriptVMScope();
+};
+
+bool IsScriptWorkerThread();
+
+#endif /* SCRIPT_THREAD_HPP */
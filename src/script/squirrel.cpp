@@ -14,6 +14,7 @@
 #include "../fileio_func.h"
 #include "../string_func.h"
 #include "script_fatalerror.hpp"
+#include "script_thread.hpp"
 #include "../settings_type.h"
 #include <sqstdaux.h>
 #include <../squirrel/sqpcheader.h>
@@ -29,10 +30,56 @@
 #define SCRIPT_DEBUG_ALLOCATIONS
  */
 
+/**
+ * Allocator for the memory of a single script VM.
+ * Small blocks, which are the bulk of the Squirrel objects, are carved out of
+ * chunks owned by the allocator. Each chunk holds blocks of one size class,
+ * and keeps its own list of freed blocks for reuse. A chunk is returned as
+ * soon as none of its blocks are in use anymore, except for the last chunk
+ * with free blocks of a size class, so allocating and freeing a single block
+ * does not allocate and free a whole chunk every time. This keeps the objects
+ * of a VM close together and prevents long-running scripts from fragmenting
+ * the general heap. The memory limit of the script applies to the chunks, not
+ * only to the blocks in use.
+ */
 struct ScriptAllocator {
 private:
+	static constexpr size_t SLAB_GRANULARITY = 16; ///< Size step between the size classes of small blocks; also their alignment.
+	static constexpr size_t SLAB_MAX_SIZE = 256; ///< Largest block that is allocated from the chunks.
+	static constexpr size_t SLAB_CLASSES = SLAB_MAX_SIZE / SLAB_GRANULARITY; ///< Number of size classes of small blocks.
+	static constexpr size_t CHUNK_SIZE = 16 * 1024; ///< Size of the chunks small blocks are allocated from; chunks are aligned to their size.
+
+	/** A free small block; it links to the next free block of the same chunk. */
+	struct FreeBlock {
+		FreeBlock *next; ///< Next free block of the same chunk.
+	};
+
+	/** Header at the start of each chunk. */
+	struct Chunk {
+		Chunk *prev = nullptr; ///< Previous chunk in the list the chunk is in.
+		Chunk *next = nullptr; ///< Next chunk in the list the chunk is in.
+		FreeBlock *free_blocks = nullptr; ///< Freed blocks of this chunk.
+		size_t unused; ///< Offset of the part of the chunk that has never been handed out.
+		size_t used = 0; ///< Number of blocks of this chunk in use.
+		size_t block_size; ///< Size of the blocks of this chunk.
+
+		/**
+		 * Whether all blocks of the chunk are in use.
+		 * @return True iff no block can be allocated from this chunk.
+		 */
+		bool IsFull() const { return this->free_blocks == nullptr && this->unused + this->block_size > CHUNK_SIZE; }
+	};
+
+	static constexpr size_t CHUNK_HEADER_SIZE = Align(sizeof(Chunk), SLAB_GRANULARITY); ///< Space taken by the header of a chunk.
+
 	std::allocator<uint8_t> allocator;
+	std::array<Chunk *, SLAB_CLASSES> available_chunks{}; ///< Chunks with free blocks, per size class.
+	Chunk *full_chunks = nullptr; ///< Chunks without free blocks.
+	size_t chunk_count = 0; ///< Number of chunks.
+	size_t large_size = 0; ///< Sum of the sizes of the blocks that are not allocated from the chunks.
+
 	size_t allocated_size = 0; ///< Sum of allocated data size
+	uint64_t allocation_count = 0; ///< Number of allocations done.
 	size_t allocation_limit; ///< Maximum this allocator may use before allocations fail
 	/**
 	 * Whether the error has already been thrown, so to not throw secondary errors in
@@ -48,25 +95,180 @@ private:
 	std::map<void *, size_t> allocations;
 #endif
 
+	/**
+	 * Get the number of bytes that allocating a block adds to the memory use of the script.
+	 * @param size The size of the block.
+	 * @return The number of bytes.
+	 */
+	size_t GetAllocationCost(size_t size) const
+	{
+		if (size > SLAB_MAX_SIZE) return size;
+		return this->available_chunks[GetSizeClass(size)] == nullptr ? CHUNK_SIZE : 0;
+	}
+
 	/**
 	 * Checks whether an allocation is allowed by the memory limit set for the script.
+	 * @param cost The number of bytes the allocation adds to the memory use.
 	 * @param requested_size The requested size that was requested to be allocated.
 	 * @throws Script_FatalError When memory may not be allocated (limit reached, except for error handling).
 	 */
-	void CheckAllocationAllowed(size_t requested_size)
+	void CheckAllocationAllowed(size_t cost, size_t requested_size)
 	{
 		/* When an error has been thrown, we are allocating just a bit of memory for the stack trace. */
 		if (this->error_thrown) return;
 
-		if (this->allocated_size + requested_size <= this->allocation_limit) return;
+		if (this->GetUsedSize() + cost <= this->allocation_limit) return;
 
 		/* Do not allow allocating more than the allocation limit. */
 		this->error_thrown = true;
 		std::string msg = fmt::format("Maximum memory allocation exceeded by {} bytes when allocating {} bytes",
-			this->allocated_size + requested_size - this->allocation_limit, requested_size);
+			this->GetUsedSize() + cost - this->allocation_limit, requested_size);
 		throw Script_FatalError(msg);
 	}
 
+	/**
+	 * Get the size class of a small block.
+	 * @param size The size of the block; at most #SLAB_MAX_SIZE.
+	 * @return The index of the size class.
+	 */
+	static size_t GetSizeClass(size_t size)
+	{
+		return size == 0 ? 0 : (size - 1) / SLAB_GRANULARITY;
+	}
+
+	/**
+	 * Get the chunk a small block was allocated from.
+	 * @param p The block.
+	 * @return The chunk.
+	 */
+	static Chunk *GetChunk(void *p)
+	{
+		return reinterpret_cast<Chunk *>(reinterpret_cast<uintptr_t>(p) & ~(CHUNK_SIZE - 1));
+	}
+
+	/**
+	 * Add a chunk to the front of a list of chunks.
+	 * @param list The first chunk of the list.
+	 * @param chunk The chunk to add.
+	 */
+	static void LinkChunk(Chunk *&list, Chunk *chunk)
+	{
+		chunk->prev = nullptr;
+		chunk->next = list;
+		if (list != nullptr) list->prev = chunk;
+		list = chunk;
+	}
+
+	/**
+	 * Remove a chunk from a list of chunks.
+	 * @param list The first chunk of the list.
+	 * @param chunk The chunk to remove.
+	 */
+	static void UnlinkChunk(Chunk *&list, Chunk *chunk)
+	{
+		if (chunk->prev != nullptr) {
+			chunk->prev->next = chunk->next;
+		} else {
+			list = chunk->next;
+		}
+		if (chunk->next != nullptr) chunk->next->prev = chunk->prev;
+	}
+
+	/**
+	 * Allocate a new chunk for small blocks.
+	 * @param size_class The size class of the blocks in the chunk.
+	 * @return The chunk, which is in the list of chunks with free blocks.
+	 */
+	Chunk *NewChunk(size_t size_class)
+	{
+		Chunk *chunk = new (::operator new(CHUNK_SIZE, std::align_val_t{CHUNK_SIZE})) Chunk();
+		chunk->unused = CHUNK_HEADER_SIZE;
+		chunk->block_size = (size_class + 1) * SLAB_GRANULARITY;
+		LinkChunk(this->available_chunks[size_class], chunk);
+		this->chunk_count++;
+		return chunk;
+	}
+
+	/**
+	 * Release a chunk that is not in any list.
+	 * @param chunk The chunk.
+	 */
+	void DeleteChunk(Chunk *chunk)
+	{
+		chunk->~Chunk();
+		::operator delete(chunk, std::align_val_t{CHUNK_SIZE});
+		this->chunk_count--;
+	}
+
+	/**
+	 * Release all chunks in a list.
+	 * @param list The first chunk of the list.
+	 */
+	void DeleteChunks(Chunk *&list)
+	{
+		while (list != nullptr) {
+			Chunk *chunk = list;
+			list = chunk->next;
+			this->DeleteChunk(chunk);
+		}
+	}
+
+	/**
+	 * Allocate a small block from the chunks.
+	 * @param size The size of the block; at most #SLAB_MAX_SIZE.
+	 * @return The allocated memory.
+	 */
+	void *AllocSmall(size_t size)
+	{
+		size_t size_class = GetSizeClass(size);
+		Chunk *chunk = this->available_chunks[size_class];
+		if (chunk == nullptr) chunk = this->NewChunk(size_class);
+
+		void *p;
+		if (chunk->free_blocks != nullptr) {
+			p = chunk->free_blocks;
+			chunk->free_blocks = chunk->free_blocks->next;
+		} else {
+			p = reinterpret_cast<std::byte *>(chunk) + chunk->unused;
+			chunk->unused += chunk->block_size;
+		}
+		chunk->used++;
+
+		if (chunk->IsFull()) {
+			UnlinkChunk(this->available_chunks[size_class], chunk);
+			LinkChunk(this->full_chunks, chunk);
+		}
+		return p;
+	}
+
+	/**
+	 * Return a small block to its chunk, and the chunk itself when it is empty.
+	 * @param p The block.
+	 * @param size The size of the block; at most #SLAB_MAX_SIZE.
+	 */
+	void FreeSmall(void *p, size_t size)
+	{
+		Chunk *&available = this->available_chunks[GetSizeClass(size)];
+		Chunk *chunk = GetChunk(p);
+		if (chunk->IsFull()) {
+			UnlinkChunk(this->full_chunks, chunk);
+			LinkChunk(available, chunk);
+		}
+
+		chunk->free_blocks = new (p) FreeBlock{chunk->free_blocks};
+		if (--chunk->used != 0) return;
+
+		/* Keep the only chunk with free blocks of this size class; it will be needed again soon. */
+		if (chunk == available && chunk->next == nullptr) {
+			chunk->free_blocks = nullptr;
+			chunk->unused = CHUNK_HEADER_SIZE;
+			return;
+		}
+
+		UnlinkChunk(available, chunk);
+		this->DeleteChunk(chunk);
+	}
+
 	/**
 	 * Internal helper to allocate the given amount of bytes.
 	 * @param requested_size The requested size.
@@ -76,9 +278,16 @@ private:
 	void *DoAlloc(SQUnsignedInteger requested_size)
 	{
 		try {
-			void *p = this->allocator.allocate(requested_size);
+			void *p;
+			if (requested_size <= SLAB_MAX_SIZE) {
+				p = this->AllocSmall(requested_size);
+			} else {
+				p = this->allocator.allocate(requested_size);
+				this->large_size += requested_size;
+			}
 			assert(p != nullptr);
 			this->allocated_size += requested_size;
+			this->allocation_count++;
 
 #ifdef SCRIPT_DEBUG_ALLOCATIONS
 			assert(this->allocations.find(p) == this->allocations.end());
@@ -104,20 +313,49 @@ private:
 public:
 	size_t GetAllocatedSize() const { return this->allocated_size; }
 
+	/**
+	 * Get the number of bytes reserved for small blocks, whether they are in use or not.
+	 * @return The reserved size.
+	 */
+	size_t GetReservedSize() const { return this->chunk_count * CHUNK_SIZE; }
+
+	/**
+	 * Get the number of bytes that count against the memory limit of the script;
+	 * the chunks for small blocks and the other blocks.
+	 * @return The used size.
+	 */
+	size_t GetUsedSize() const { return this->GetReservedSize() + this->large_size; }
+
+	/**
+	 * Get the maximum number of bytes the script may use.
+	 * @return The limit.
+	 */
+	size_t GetLimit() const { return this->allocation_limit; }
+
+	/**
+	 * Get the number of allocations done since the allocator was created.
+	 * @return The number of allocations.
+	 */
+	uint64_t GetAllocationCount() const { return this->allocation_count; }
+
 	void CheckLimit() const
 	{
-		if (this->allocated_size > this->allocation_limit) throw Script_FatalError("Maximum memory allocation exceeded");
+		if (this->GetUsedSize() > this->allocation_limit) throw Script_FatalError("Maximum memory allocation exceeded");
 	}
 
 	void Reset()
 	{
 		assert(this->allocated_size == 0);
 		this->error_thrown = false;
+
+		/* Nothing is allocated anymore, so release all chunks. */
+		for (Chunk *&list : this->available_chunks) this->DeleteChunks(list);
+		this->DeleteChunks(this->full_chunks);
 	}
 
 	void *Malloc(SQUnsignedInteger size)
 	{
-		this->CheckAllocationAllowed(size);
+		this->CheckAllocationAllowed(this->GetAllocationCost(size), size);
 		return this->DoAlloc(size);
 	}
 
@@ -130,8 +368,20 @@ public:
 			this->Free(p, oldsize);
 			return nullptr;
 		}
+		/* Small blocks of the same size class can grow or shrink in place. */
+		if (oldsize <= SLAB_MAX_SIZE && size <= SLAB_MAX_SIZE && GetSizeClass(oldsize) == GetSizeClass(size)) {
+			this->allocated_size = this->allocated_size + size - oldsize;
+#ifdef SCRIPT_DEBUG_ALLOCATIONS
+			assert(this->allocations.at(p) == oldsize);
+			this->allocations[p] = size;
+#endif
+			return p;
+		}
 
-		this->CheckAllocationAllowed(size - oldsize);
+		/* The old block is freed right after, so only the growth counts. */
+		size_t cost = this->GetAllocationCost(size);
+		size_t refund = oldsize > SLAB_MAX_SIZE ? oldsize : 0;
+		this->CheckAllocationAllowed(cost > refund ? cost - refund : 0, size);
 
 		void *new_p = this->DoAlloc(size);
 		std::copy_n(static_cast<std::byte *>(p), std::min(oldsize, size), static_cast<std::byte *>(new_p));
@@ -143,7 +393,12 @@ public:
 	void Free(void *p, SQUnsignedInteger size)
 	{
 		if (p == nullptr) return;
-		this->allocator.deallocate(reinterpret_cast<uint8_t*>(p), size);
+		if (size <= SLAB_MAX_SIZE) {
+			this->FreeSmall(p, size);
+		} else {
+			this->allocator.deallocate(reinterpret_cast<uint8_t*>(p), size);
+			this->large_size -= size;
+		}
 		this->allocated_size -= size;
 
 #ifdef SCRIPT_DEBUG_ALLOCATIONS
@@ -163,10 +418,12 @@ public:
 #ifdef SCRIPT_DEBUG_ALLOCATIONS
 		assert(this->allocations.empty());
 #endif
+		for (Chunk *&list : this->available_chunks) this->DeleteChunks(list);
+		this->DeleteChunks(this->full_chunks);
 	}
 };
 
-ScriptAllocator *_squirrel_allocator = nullptr;
+thread_local ScriptAllocator *_squirrel_allocator = nullptr;
 
 void *sq_vm_malloc(SQUnsignedInteger size) { return _squirrel_allocator->Malloc(size); }
 void *sq_vm_realloc(void *p, SQUnsignedInteger oldsize, SQUnsignedInteger size) { return _squirrel_allocator->Realloc(p, oldsize, size); }
@@ -178,9 +435,26 @@ size_t Squirrel::GetAllocatedMemory() const noexcept
 	return this->allocator->GetAllocatedSize();
 }
 
+ScriptMemoryStatistics Squirrel::GetMemoryStatistics() const
+{
+	assert(this->allocator != nullptr);
+
+	ScriptMemoryStatistics stats;
+	stats.allocated = this->allocator->GetAllocatedSize();
+	stats.reserved = this->allocator->GetReservedSize();
+	stats.used = this->allocator->GetUsedSize();
+	stats.limit = this->allocator->GetLimit();
+	stats.allocations = this->allocator->GetAllocationCount();
+	stats.collections = this->collections;
+	stats.last_collected = this->last_collected;
+	stats.last_collection_time = this->last_collection_time;
+	return stats;
+}
+
 
 void Squirrel::CompileError(HSQUIRRELVM vm, std::string_view desc, std::string_view source, SQInteger line, SQInteger column)
 {
+	ScriptGameStateScope game_state;
 	std::string msg = fmt::format("Error {}:{}/{}: {}", source, line, column, desc);
 
 	/* Check if we have a custom print function */
@@ -207,6 +481,8 @@ void Squirrel::ErrorPrintFunc(HSQUIRRELVM vm, std::string_view s)
 
 void Squirrel::RunError(HSQUIRRELVM vm, std::string_view error)
 {
+	ScriptGameStateScope game_state;
+
 	/* Set the print function to something that prints to stderr */
 	SQPRINTFUNCTION pf = sq_getprintfunc(vm);
 	sq_setprintfunc(vm, &Squirrel::ErrorPrintFunc);
@@ -244,6 +520,8 @@ SQInteger Squirrel::_RunError(HSQUIRRELVM vm)
 
 void Squirrel::PrintFunc(HSQUIRRELVM vm, std::string_view s)
 {
+	ScriptGameStateScope game_state;
+
 	/* Check if we have a custom print function */
 	SQPrintFunc *func = ((Squirrel *)sq_getforeignptr(vm))->print_func;
 	if (func == nullptr) {
@@ -370,7 +648,15 @@ void Squirrel::ResumeError()
 void Squirrel::CollectGarbage()
 {
 	ScriptAllocatorScope alloc_scope(this);
-	sq_collectgarbage(this->vm);
+
+	auto start = std::chrono::steady_clock::now();
+	this->last_collected = sq_collectgarbage(this->vm);
+	this->last_collection_time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+	this->collections++;
+
+	Debug(script, 4, "[{}] Collected {} objects in {} us; {} bytes allocated, {} bytes reserved, {} of {} bytes used",
+		this->api_name, this->last_collected, this->last_collection_time.count(), this->allocator->GetAllocatedSize(), this->allocator->GetReservedSize(),
+		this->allocator->GetUsedSize(), this->allocator->GetLimit());
 }
 
 bool Squirrel::CallMethod(HSQOBJECT instance, std::string_view method_name, HSQOBJECT *ret, int suspend)
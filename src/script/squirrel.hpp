@@ -10,6 +10,7 @@
 #ifndef SQUIRREL_HPP
 #define SQUIRREL_HPP
 
+#include <chrono>
 #include <squirrel.h>
 #include "../core/convertible_through_base.hpp"
 
@@ -21,6 +22,18 @@ enum class ScriptType : uint8_t {
 
 struct ScriptAllocator;
 
+/** Statistics about the memory use and garbage collection of a script VM. */
+struct ScriptMemoryStatistics {
+	size_t allocated = 0; ///< Number of bytes allocated by the VM.
+	size_t reserved = 0; ///< Number of bytes reserved for the small objects of the VM, whether they are in use or not.
+	size_t used = 0; ///< Number of bytes counted against the memory limit: the reserved bytes and the bytes of the other objects.
+	size_t limit = 0; ///< Maximum number of bytes the VM may use.
+	uint64_t allocations = 0; ///< Number of allocations done by the VM.
+	uint collections = 0; ///< Number of garbage collections run.
+	SQInteger last_collected = 0; ///< Number of objects freed by the last garbage collection.
+	std::chrono::microseconds last_collection_time{}; ///< Duration of the last garbage collection.
+};
+
 class Squirrel {
 	friend class ScriptAllocatorScope;
 	friend class ScriptInstance;
@@ -35,6 +48,9 @@ private:
 	int overdrawn_ops;       ///< The amount of operations we have overdrawn.
 	std::string_view api_name; ///< Name of the API used for this squirrel.
 	std::unique_ptr<ScriptAllocator> allocator; ///< Allocator object used by this script.
+	uint collections = 0;    ///< Number of garbage collections run.
+	SQInteger last_collected = 0; ///< Number of objects freed by the last garbage collection.
+	std::chrono::microseconds last_collection_time{}; ///< Duration of the last garbage collection.
 
 	/**
 	 * The internal RunError handler. It looks up the real error and calls RunError with it.
@@ -285,10 +301,15 @@ public:
 	 * Get number of bytes allocated by this VM.
 	 */
 	size_t GetAllocatedMemory() const noexcept;
+
+	/**
+	 * Get statistics about the memory use and garbage collection of this VM.
+	 */
+	ScriptMemoryStatistics GetMemoryStatistics() const;
 };
 
 
-extern ScriptAllocator *_squirrel_allocator;
+extern thread_local ScriptAllocator *_squirrel_allocator;
 
 class ScriptAllocatorScope {
 	ScriptAllocator *old_allocator;
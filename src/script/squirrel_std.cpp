@@ -12,6 +12,7 @@
 #include <sqstdmath.h>
 #include "../debug.h"
 #include "squirrel_std.hpp"
+#include "script_thread.hpp"
 #include "../core/math_func.hpp"
 #include "../string_func.h"
 
@@ -40,6 +41,8 @@ SQInteger SquirrelStd::max(HSQUIRRELVM vm)
 
 SQInteger SquirrelStd::require(HSQUIRRELVM vm)
 {
+	ScriptGameStateScope game_state;
+
 	SQInteger top = sq_gettop(vm);
 	std::string_view filename;
 
@@ -846,6 +846,7 @@ SettingsContainer &GetSettingsTree()
 			genworld->Add(new SettingEntry("game_creation.snow_line_height"));
 			genworld->Add(new SettingEntry("game_creation.desert_coverage"));
 			genworld->Add(new SettingEntry("game_creation.amount_of_rivers"));
+			genworld->Add(new SettingEntry("game_creation.river_generator"));
 		}
 
 		SettingsPage *environment = main->Add(new SettingsPage(STR_CONFIG_SETTING_ENVIRONMENT));
@@ -924,6 +925,7 @@ SettingsContainer &GetSettingsTree()
 				npc->Add(new SettingEntry("script.script_max_memory_megabytes"));
 				npc->Add(new SettingEntry("difficulty.competitor_speed"));
 				npc->Add(new SettingEntry("ai.ai_in_multiplayer"));
+				npc->Add(new SettingEntry("ai.ai_parallel_execution"));
 				npc->Add(new SettingEntry("ai.ai_disable_veh_train"));
 				npc->Add(new SettingEntry("ai.ai_disable_veh_roadveh"));
 				npc->Add(new SettingEntry("ai.ai_disable_veh_aircraft"));
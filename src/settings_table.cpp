@@ -164,7 +164,7 @@ static void RedrawSmallmap(int32_t)
 {
 	BuildLandLegend();
 	BuildOwnerLegend();
-	SetWindowClassesDirty(WC_SMALLMAP);
+	InvalidateWindowClassesData(WC_SMALLMAP, 3);
 }
 
 /** Redraw linkgraph links after a colour scheme change. */
@@ -376,7 +376,7 @@ static void TownFoundingChanged(int32_t)
 static void ZoomMinMaxChanged(int32_t)
 {
 	ConstrainAllViewportsZoom();
-	GfxClearSpriteCache();
+	GfxClearSpriteCache(true);
 	InvalidateWindowClassesData(WC_SPRITE_ALIGNER);
 	if (AdjustGUIZoom(false)) {
 		ReInitAllWindows(true);
@@ -385,7 +385,7 @@ static void ZoomMinMaxChanged(int32_t)
 
 static void SpriteZoomMinChanged(int32_t)
 {
-	GfxClearSpriteCache();
+	GfxClearSpriteCache(true);
 	/* Force all sprites to redraw at the new chosen zoom level */
 	MarkWholeScreenDirty();
 }
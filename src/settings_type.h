@@ -382,6 +382,7 @@ struct GameCreationSettings {
 	uint8_t min_river_length;                 ///< the minimum river length
 	uint8_t river_route_random;               ///< the amount of randomicity for the route finding
 	uint8_t amount_of_rivers;                 ///< the amount of rivers
+	uint8_t river_generator;                  ///< the algorithm used to generate rivers
 };
 
 /** Settings related to construction in-game */
@@ -416,6 +417,7 @@ struct ConstructionSettings {
 /** Settings related to the AI. */
 struct AISettings {
 	bool   ai_in_multiplayer;                ///< so we allow AIs in multiplayer
+	bool   ai_parallel_execution;            ///< run the AIs on worker threads
 	bool   ai_disable_veh_train;             ///< disable types for AI
 	bool   ai_disable_veh_roadveh;           ///< disable types for AI
 	bool   ai_disable_veh_aircraft;          ///< disable types for AI
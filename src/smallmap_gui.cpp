@@ -623,6 +623,144 @@ enum SmallMapType : uint8_t {
 };
 DECLARE_ENUM_AS_ADDABLE(SmallMapType)
 
+/**
+ * Cache of the colours shown by the smallmap, so a redraw only has to look at the tiles that changed.
+ * At a given zoom level every tile belongs to exactly one group of zoom x zoom tiles that is drawn
+ * as one pixel pair; the cache keeps the colours of these groups. They are stored in blocks that are
+ * only allocated once a part of the map is shown.
+ */
+class SmallMapRaster {
+	static constexpr uint BLOCK_BITS = 6; ///< Log2 of the width and height of a block, in groups.
+	static constexpr uint BLOCK_SIZE = 1U << BLOCK_BITS; ///< Width and height of a block, in groups.
+
+	/** Colours of a square of groups. */
+	struct Block {
+		std::array<uint32_t, BLOCK_SIZE * BLOCK_SIZE> colours; ///< Colours of the groups.
+		std::bitset<BLOCK_SIZE * BLOCK_SIZE> valid; ///< Which of the colours are up to date.
+	};
+
+	SmallMapType map_type{}; ///< Map type the colours are of.
+	int zoom = 0; ///< Zoom level the colours are of; 0 when nothing is cached.
+	uint phase_x = 0; ///< X coordinate of the first tile of a group, modulo the zoom level.
+	uint phase_y = 0; ///< Y coordinate of the first tile of a group, modulo the zoom level.
+	uint blocks_x = 0; ///< Number of blocks along the x axis of the map.
+	std::vector<std::unique_ptr<Block>> blocks; ///< Blocks of the map, or \c nullptr when not shown yet.
+
+	/**
+	 * Find the location of the colours of a group.
+	 * @param xc X coordinate of the first tile of the group.
+	 * @param yc Y coordinate of the first tile of the group.
+	 * @return The index of the block and the index of the group within the block.
+	 */
+	std::pair<size_t, size_t> Locate(uint xc, uint yc) const
+	{
+		uint gx = xc / this->zoom;
+		uint gy = yc / this->zoom;
+		return {(gy >> BLOCK_BITS) * this->blocks_x + (gx >> BLOCK_BITS), (gy & (BLOCK_SIZE - 1)) * BLOCK_SIZE + (gx & (BLOCK_SIZE - 1))};
+	}
+
+public:
+	/**
+	 * Make sure the cache is for the given way of drawing the map; drop all colours if it is not.
+	 * @param map_type Map type to draw.
+	 * @param zoom Zoom level to draw at.
+	 * @param phase_x X coordinate of the first tile of a group, modulo the zoom level.
+	 * @param phase_y Y coordinate of the first tile of a group, modulo the zoom level.
+	 */
+	void Prepare(SmallMapType map_type, int zoom, uint phase_x, uint phase_y)
+	{
+		if (this->zoom == zoom && this->map_type == map_type && this->phase_x == phase_x && this->phase_y == phase_y) return;
+
+		this->map_type = map_type;
+		this->zoom = zoom;
+		this->phase_x = phase_x;
+		this->phase_y = phase_y;
+		this->blocks_x = CeilDiv(Map::SizeX() / zoom + 1, BLOCK_SIZE);
+		this->blocks.clear();
+		this->blocks.resize(this->blocks_x * CeilDiv(Map::SizeY() / zoom + 1, BLOCK_SIZE));
+	}
+
+	/**
+	 * Get the cached colours of a group.
+	 * @param xc X coordinate of the first tile of the group.
+	 * @param yc Y coordinate of the first tile of the group.
+	 * @param[out] colours The colours, when they are cached.
+	 * @return Whether the colours are cached and up to date.
+	 */
+	bool Get(uint xc, uint yc, uint32_t &colours) const
+	{
+		auto [block, index] = this->Locate(xc, yc);
+		const Block *b = this->blocks[block].get();
+		if (b == nullptr || !b->valid.test(index)) return false;
+
+		colours = b->colours[index];
+		return true;
+	}
+
+	/**
+	 * Store the colours of a group.
+	 * @param xc X coordinate of the first tile of the group.
+	 * @param yc Y coordinate of the first tile of the group.
+	 * @param colours The colours.
+	 */
+	void Set(uint xc, uint yc, uint32_t colours)
+	{
+		auto [block, index] = this->Locate(xc, yc);
+		std::unique_ptr<Block> &b = this->blocks[block];
+		if (b == nullptr) b = std::make_unique<Block>();
+
+		b->colours[index] = colours;
+		b->valid.set(index);
+	}
+
+	/**
+	 * Mark the colours of the group containing a tile as outdated.
+	 * @param tile The tile that changed.
+	 */
+	void InvalidateTile(TileIndex tile)
+	{
+		if (this->zoom == 0) return;
+
+		uint x = TileX(tile);
+		uint y = TileY(tile);
+		/* Tiles before the first group are never drawn. */
+		if (x < this->phase_x || y < this->phase_y) return;
+
+		auto [block, index] = this->Locate(x - (x - this->phase_x) % this->zoom, y - (y - this->phase_y) % this->zoom);
+		if (this->blocks[block] != nullptr) this->blocks[block]->valid.reset(index);
+	}
+
+	/**
+	 * Mark the colours of some of the blocks as outdated, for changes of which no tile notification is sent.
+	 * @param part Which part of the blocks to mark, 0 .. \a parts - 1.
+	 * @param parts Number of parts the blocks are divided into.
+	 */
+	void InvalidatePart(uint part, uint parts)
+	{
+		for (size_t i = part; i < this->blocks.size(); i += parts) {
+			if (this->blocks[i] != nullptr) this->blocks[i]->valid.reset();
+		}
+	}
+
+	/** Drop all cached colours. */
+	void Invalidate()
+	{
+		this->zoom = 0;
+		this->blocks.clear();
+	}
+};
+
+static SmallMapRaster *_smallmap_raster = nullptr; ///< The colour cache of the open smallmap window, if any.
+
+/**
+ * Notify the smallmap that a tile changed, so its colour gets recomputed.
+ * @param tile The tile that changed.
+ */
+void InvalidateSmallMapTile(TileIndex tile)
+{
+	if (_smallmap_raster != nullptr) _smallmap_raster->InvalidateTile(tile);
+}
+
 /** Class managing the smallmap window. */
 class SmallMapWindow : public Window {
 protected:
@@ -652,6 +790,10 @@ protected:
 
 	std::unique_ptr<LinkGraphOverlay> overlay{};
 
+	static constexpr uint RASTER_REFRESH_PARTS = 8; ///< Number of refresh intervals in which all cached colours are recomputed, to catch changes without a tile notification.
+	mutable SmallMapRaster raster{}; ///< Cached colours of the map.
+	uint raster_refresh_part = 0; ///< Part of the cached colours to recompute at the next refresh interval.
+
 	/** Notify the industry chain window to stop sending newly selected industries. */
 	static void BreakIndustryChainLink()
 	{
@@ -814,6 +956,7 @@ protected:
 		}
 
 		if (this->map_type == SMT_INDUSTRY) this->BreakIndustryChainLink();
+		this->raster.Invalidate();
 	}
 
 	/**
@@ -867,7 +1010,7 @@ protected:
 		this->scroll_x = sx;
 		this->scroll_y = sy;
 		this->subscroll = sub;
-		if (this->map_type == SMT_LINKSTATS) this->overlay->SetDirty();
+		if (this->map_type == SMT_LINKSTATS) this->overlay->SetViewDirty();
 	}
 
 	/**
@@ -920,18 +1063,23 @@ protected:
 			if (dst < _screen.dst_ptr) continue;
 			if (dst >= dst_ptr_abs_end) continue;
 
-			/* Construct tilearea covered by (xc, yc, xc + this->zoom, yc + this->zoom) such that it is within min_xy limits. */
-			TileArea ta;
-			if (min_xy == 1 && (xc == 0 || yc == 0)) {
-				if (this->zoom == 1) continue; // The tile area is empty, don't draw anything.
+			/* The tile area is empty, don't draw anything. */
+			if (min_xy == 1 && (xc == 0 || yc == 0) && this->zoom == 1) continue;
 
-				ta = TileArea(TileXY(std::max(min_xy, xc), std::max(min_xy, yc)), this->zoom - (xc == 0), this->zoom - (yc == 0));
-			} else {
-				ta = TileArea(TileXY(xc, yc), this->zoom, this->zoom);
-			}
-			ta.ClampToMap(); // Clamp to map boundaries (may contain MP_VOID tiles!).
+			uint32_t val;
+			if (!this->raster.Get(xc, yc, val)) {
+				/* Construct tilearea covered by (xc, yc, xc + this->zoom, yc + this->zoom) such that it is within min_xy limits. */
+				TileArea ta;
+				if (min_xy == 1 && (xc == 0 || yc == 0)) {
+					ta = TileArea(TileXY(std::max(min_xy, xc), std::max(min_xy, yc)), this->zoom - (xc == 0), this->zoom - (yc == 0));
+				} else {
+					ta = TileArea(TileXY(xc, yc), this->zoom, this->zoom);
+				}
+				ta.ClampToMap(); // Clamp to map boundaries (may contain MP_VOID tiles!).
 
-			uint32_t val = this->GetTileColours(ta);
+				val = this->GetTileColours(ta);
+				this->raster.Set(xc, yc, val);
+			}
 			uint8_t *val8 = (uint8_t *)&val;
 			int idx = std::max(0, -start_pos);
 			for (int pos = std::max(0, start_pos); pos < end_pos; pos++) {
@@ -1068,6 +1216,9 @@ protected:
 		int tile_x = this->scroll_x / (int)TILE_SIZE + tile.x;
 		int tile_y = this->scroll_y / (int)TILE_SIZE + tile.y;
 
+		/* All tiles drawn are a whole number of zoom steps away from the first one, so this decides how tiles are grouped into pixels. */
+		this->raster.Prepare(this->map_type, this->zoom, ((tile_x % this->zoom) + this->zoom) % this->zoom, ((tile_y % this->zoom) + this->zoom) % this->zoom);
+
 		void *ptr = blitter->MoveTo(dpi->dst_ptr, -dx - 4, 0);
 		int x = - dx - 4;
 		int y = 0;
@@ -1241,7 +1392,7 @@ protected:
 				this->SetNewScroll(this->scroll_x + (tile.x - new_tile.x) * TILE_SIZE,
 						this->scroll_y + (tile.y - new_tile.y) * TILE_SIZE, sub);
 			} else if (this->map_type == SMT_LINKSTATS) {
-				this->overlay->SetDirty();
+				this->overlay->SetViewDirty();
 			}
 			this->SetWidgetDisabledState(WID_SM_ZOOM_IN,  this->zoom == zoomlevels[MIN_ZOOM_INDEX]);
 			this->SetWidgetDisabledState(WID_SM_ZOOM_OUT, this->zoom == zoomlevels[MAX_ZOOM_INDEX]);
@@ -1434,6 +1585,7 @@ protected:
 
 		_smallmap_industry_highlight_state = !_smallmap_industry_highlight_state;
 
+		this->raster.Invalidate();
 		this->UpdateLinks();
 		this->SetDirty();
 	}
@@ -1443,6 +1595,8 @@ protected:
 	{
 		if (_smallmap_industry_highlight != IT_INVALID) return;
 
+		this->raster.InvalidatePart(this->raster_refresh_part, RASTER_REFRESH_PARTS);
+		this->raster_refresh_part = (this->raster_refresh_part + 1) % RASTER_REFRESH_PARTS;
 		this->UpdateLinks();
 		this->SetDirty();
 	}
@@ -1470,6 +1624,8 @@ public:
 		this->SetZoomLevel(ZLC_INITIALIZE, nullptr);
 		this->SmallMapCenterOnCurrentPos();
 		this->SetOverlayCargoMask();
+
+		_smallmap_raster = &this->raster;
 	}
 
 	/**
@@ -1508,6 +1664,7 @@ public:
 
 	void Close([[maybe_unused]] int data) override
 	{
+		if (_smallmap_raster == &this->raster) _smallmap_raster = nullptr;
 		this->BreakIndustryChainLink();
 		this->Window::Close();
 	}
@@ -1800,6 +1957,7 @@ public:
 					tbl->show_on_map = (widget == WID_SM_ENABLE_ALL);
 				}
 				if (this->map_type == SMT_LINKSTATS) this->SetOverlayCargoMask();
+				this->raster.Invalidate();
 				this->SetDirty();
 				break;
 			}
@@ -1807,6 +1965,7 @@ public:
 			case WID_SM_SHOW_HEIGHT: // Enable/disable showing of heightmap.
 				_smallmap_show_heightmap = !_smallmap_show_heightmap;
 				this->SetWidgetLoweredState(WID_SM_SHOW_HEIGHT, _smallmap_show_heightmap);
+				this->raster.Invalidate();
 				this->SetDirty();
 				break;
 		}
@@ -1818,6 +1977,7 @@ public:
 	 * - data = 0: Displayed industries at the industry chain window have changed.
 	 * - data = 1: Companies have changed.
 	 * - data = 2: Cheat changing the maximum heightlevel has been used, rebuild our heightlevel-to-colour index
+	 * - data = 3: The colour scheme has changed.
 	 * @param gui_scope Whether the call is done from GUI scope. You may not do everything when not in GUI scope. See #InvalidateWindowData() for details.
 	 */
 	void OnInvalidateData(int data = 0, bool gui_scope = true) override
@@ -1844,8 +2004,12 @@ public:
 				this->RebuildColourIndexIfNecessary();
 				break;
 
+			case 3:
+				break;
+
 			default: NOT_REACHED();
 		}
+		this->raster.Invalidate();
 		this->SetDirty();
 	}
 
@@ -1893,6 +2057,7 @@ public:
 		if (new_highlight != _smallmap_industry_highlight) {
 			_smallmap_industry_highlight = new_highlight;
 			_smallmap_industry_highlight_state = true;
+			this->raster.Invalidate();
 			this->SetDirty();
 		}
 	}
@@ -31,6 +31,7 @@ enum class IncludeHeightmap : uint8_t {
 };
 
 uint32_t GetSmallMapOwnerPixels(TileIndex tile, TileType t, IncludeHeightmap include_heightmap);
+void InvalidateSmallMapTile(TileIndex tile);
 
 Point GetSmallMapStationMiddle(const Window *w, const Station *st);
 
@@ -256,6 +256,60 @@ public:
 		if (this->IsSortable()) std::reverse(std::vector<T>::begin(), std::vector<T>::end());
 	}
 
+	/**
+	 * Sort a range that is mostly sorted already by taking out the items that are
+	 * out of place, sorting only those, and merging them back in; or sort it
+	 * completely when too many items are out of place.
+	 * Most resorts happen because a few items changed since the last sort, so this
+	 * saves most of the comparisons, and with that most of the sort keys to look up.
+	 * @param first The begin of the range.
+	 * @param last The end of the range.
+	 * @param comp The function to compare two items.
+	 */
+	template <typename Iter, typename Comp>
+	static void SortIncremental(Iter first, Iter last, Comp comp)
+	{
+		/* Up to this many items may be out of place to sort incrementally. */
+		const size_t max_moved = std::max<size_t>(8, std::distance(first, last) / 16);
+
+		std::vector<T> kept;
+		std::vector<T> moved;
+		kept.reserve(std::distance(first, last));
+		bool incremental = true;
+		for (Iter it = first; it != last; ++it) {
+			bool out_of_place = false;
+			if (incremental) {
+				Iter next = std::next(it);
+				while (!kept.empty() && comp(*it, kept.back())) {
+					/* Unless the next item is out of order with the previous item too, this item is the one out of place. */
+					if (next == last || !comp(*next, kept.back())) {
+						out_of_place = true;
+						break;
+					}
+					moved.push_back(std::move(kept.back()));
+					kept.pop_back();
+				}
+			}
+			if (out_of_place) {
+				moved.push_back(std::move(*it));
+			} else {
+				kept.push_back(std::move(*it));
+			}
+			if (moved.size() > max_moved) incremental = false;
+		}
+
+		if (!incremental) {
+			Iter end = std::move(kept.begin(), kept.end(), first);
+			std::move(moved.begin(), moved.end(), end);
+			std::sort(first, last, comp);
+			return;
+		}
+
+		std::sort(moved.begin(), moved.end(), comp);
+		std::merge(std::make_move_iterator(kept.begin()), std::make_move_iterator(kept.end()),
+				std::make_move_iterator(moved.begin()), std::make_move_iterator(moved.end()), first, comp);
+	}
+
 	/**
 	 * Sort the list.
 	 * @param compare The function to compare two list items
@@ -278,9 +332,9 @@ public:
 		const bool desc = this->flags.Test(SortListFlag::Desc);
 
 		if constexpr (std::is_same_v<P, std::nullptr_t>) {
-			std::sort(std::vector<T>::begin(), std::vector<T>::end(), [&](const T &a, const T &b) { return desc ? compare(b, a) : compare(a, b); });
+			SortIncremental(std::vector<T>::begin(), std::vector<T>::end(), [&](const T &a, const T &b) { return desc ? compare(b, a) : compare(a, b); });
 		} else {
-			std::sort(std::vector<T>::begin(), std::vector<T>::end(), [&](const T &a, const T &b) { return desc ? compare(b, a, params) : compare(a, b, params); });
+			SortIncremental(std::vector<T>::begin(), std::vector<T>::end(), [&](const T &a, const T &b) { return desc ? compare(b, a, params) : compare(a, b, params); });
 		}
 		return true;
 	}
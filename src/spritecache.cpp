@@ -17,22 +17,43 @@
 #include "blitter/factory.hpp"
 #include "core/math_func.hpp"
 #include "video/video_driver.hpp"
+#include "thread.h"
+#include "fileio_func.h"
+#include "string_func.h"
+#include "tar_type.h"
+#include "rev.h"
+#include "core/random_func.hpp"
+#include "3rdparty/md5/md5.h"
 #include "spritecache.h"
 #include "spritecache_internal.h"
 
 #include "table/sprites.h"
 #include "table/palette_convert.h"
 
+#include <filesystem>
+
 #include "safeguards.h"
 
 /* Default of 4MB spritecache */
 uint _sprite_cache_size = 4;
+/* Whether to keep encoded sprites in cache files on disk. */
+bool _sprite_disk_cache = false;
+/* Size limit in MiB of the sprite disk cache files together. */
+uint _sprite_disk_cache_size = 256;
+/* Whether to defer reading the sprite sections of GRFs until one of their sprites is needed. */
+bool _sprite_lazy_index = true;
 
 
 static std::vector<SpriteCache> _spritecache;
 static size_t _spritecache_bytes_used = 0;
-static uint32_t _sprite_lru_counter;
+static std::vector<SpriteID> _sprite_clock; ///< Sprites with data in the sprite cache, in the order the eviction clock visits them.
+static size_t _sprite_clock_hand = 0; ///< Position in #_sprite_clock the eviction clock looks at next.
+static SpriteCacheStats _sprite_cache_stats; ///< Statistics of the sprite cache; the sizes are filled on request.
 static std::vector<std::unique_ptr<SpriteFile>> _sprite_files;
+static std::chrono::steady_clock::time_point _sprite_disk_cache_last_use; ///< Moment the disk caches were used the last time since they were flushed.
+
+/** Time the disk caches have to be unused before their files are closed and new sprites are written. */
+static constexpr auto SPRITE_DISK_CACHE_IDLE_TIME = std::chrono::seconds(2);
 
 static inline SpriteCache *GetSpriteCache(uint index)
 {
@@ -444,23 +465,23 @@ static void *ReadRecolourSprite(SpriteFile &file, size_t file_pos, uint num, Spr
 }
 
 /**
- * Read a sprite from disk.
+ * Read a sprite from disk and encode it, without falling back to another sprite on failure.
+ * This does not touch any global state, so it may be called from several threads at once
+ * as long as each thread uses its own \a file and the encoder supports it.
  * @param sc          Location of sprite.
+ * @param file        The file to read the sprite from; the file of \a sc or another handle of it.
  * @param id          Sprite number.
  * @param sprite_type Type of sprite.
  * @param allocator   Allocator function to use.
  * @param encoder     Sprite encoder to use.
- * @return Read sprite data.
+ * @return Read sprite data, or \c nullptr when it could not be loaded.
  */
-static void *ReadSprite(const SpriteCache *sc, SpriteID id, SpriteType sprite_type, SpriteAllocator &allocator, SpriteEncoder *encoder)
+static void *DecodeSprite(const SpriteCache *sc, SpriteFile &file, SpriteID id, SpriteType sprite_type, SpriteAllocator &allocator, SpriteEncoder *encoder)
 {
-	/* Use current blitter if no other sprite encoder is given. */
-	if (encoder == nullptr) encoder = BlitterFactory::GetCurrentBlitter();
-
-	SpriteFile &file = *sc->file;
 	size_t file_pos = sc->file_pos;
 
 	assert(sprite_type != SpriteType::Recolour);
+	assert(!sc->lazy_offset);
 	assert(IsMapgenSpriteID(id) == (sprite_type == SpriteType::MapGen));
 	assert(sc->type == sprite_type);
 
@@ -485,11 +506,7 @@ static void *ReadSprite(const SpriteCache *sc, SpriteID id, SpriteType sprite_ty
 		}
 	}
 
-	if (sprite_avail.None()) {
-		if (sprite_type == SpriteType::MapGen) return nullptr;
-		if (id == SPR_IMG_QUERY) UserError("Okay... something went horribly wrong. I couldn't load the fallback sprite. What should I do?");
-		return (void*)GetRawSprite(SPR_IMG_QUERY, SpriteType::Normal, &allocator, encoder);
-	}
+	if (sprite_avail.None()) return nullptr;
 
 	if (sprite_type == SpriteType::MapGen) {
 		/* Ugly hack to work around the problem that the old landscape
@@ -520,10 +537,7 @@ static void *ReadSprite(const SpriteCache *sc, SpriteID id, SpriteType sprite_ty
 		return s;
 	}
 
-	if (!ResizeSprites(sprite, sprite_avail, encoder)) {
-		if (id == SPR_IMG_QUERY) UserError("Okay... something went horribly wrong. I couldn't resize the fallback sprite. What should I do?");
-		return (void*)GetRawSprite(SPR_IMG_QUERY, SpriteType::Normal, &allocator, encoder);
-	}
+	if (!ResizeSprites(sprite, sprite_avail, encoder)) return nullptr;
 
 	if (sprite_type == SpriteType::Font && _font_zoom != ZoomLevel::Min) {
 		/* Make ZoomLevel::Min the desired font zoom level. */
@@ -533,6 +547,27 @@ static void *ReadSprite(const SpriteCache *sc, SpriteID id, SpriteType sprite_ty
 	return encoder->Encode(sprite_type, sprite, allocator);
 }
 
+/**
+ * Read a sprite from disk.
+ * @param sc          Location of sprite.
+ * @param id          Sprite number.
+ * @param sprite_type Type of sprite.
+ * @param allocator   Allocator function to use.
+ * @param encoder     Sprite encoder to use.
+ * @return Read sprite data.
+ */
+static void *ReadSprite(const SpriteCache *sc, SpriteID id, SpriteType sprite_type, SpriteAllocator &allocator, SpriteEncoder *encoder)
+{
+	/* Use current blitter if no other sprite encoder is given. */
+	if (encoder == nullptr) encoder = BlitterFactory::GetCurrentBlitter();
+
+	void *data = DecodeSprite(sc, *sc->file, id, sprite_type, allocator, encoder);
+	if (data != nullptr || sprite_type == SpriteType::MapGen) return data;
+
+	if (id == SPR_IMG_QUERY) UserError("Okay... something went horribly wrong. I couldn't load the fallback sprite. What should I do?");
+	return GetRawSprite(SPR_IMG_QUERY, SpriteType::Normal, &allocator, encoder);
+}
+
 struct GrfSpriteOffset {
 	size_t file_pos;
 	SpriteCacheCtrlFlags control_flags{};
@@ -541,6 +576,102 @@ struct GrfSpriteOffset {
 /** Map from sprite numbers to position in the GRF file. */
 static std::map<uint32_t, GrfSpriteOffset> _grf_sprite_offsets;
 
+/** Sprite offsets of GRFs that were read ahead of loading them, indexed by file name and sub directory. */
+static std::map<std::pair<std::string, Subdirectory>, std::map<uint32_t, GrfSpriteOffset>> _grf_sprite_offsets_preloaded;
+
+/** Thread reading the sprite sections ahead for the lazy index, while the GRFs are being loaded; it owns #_grf_sprite_offsets_preloaded until it is joined. */
+static std::thread _grf_sprite_offsets_thread;
+
+/** Sprite section of a GRF that is only read once one of its sprites is needed. */
+struct LazySpriteSection {
+	size_t begin; ///< Position of the sprite section in the file.
+	std::optional<std::map<uint32_t, GrfSpriteOffset>> offsets; ///< Map from sprite numbers to position in the GRF file, once read.
+};
+
+/** Sprite sections of the cached sprite files that are read lazily. */
+static std::map<const SpriteFile *, LazySpriteSection> _lazy_sprite_sections;
+
+/** The GRF currently being loaded, when its sprite section is read lazily. */
+static SpriteFile *_lazy_sprite_section_file = nullptr;
+
+/**
+ * Read the sprite section of a GRF.
+ * @param file The GRF, positioned at the start of its sprite section.
+ * @return Map from sprite numbers to their position in the GRF file.
+ */
+static std::map<uint32_t, GrfSpriteOffset> ReadGRFSpriteSection(SpriteFile &file)
+{
+	std::map<uint32_t, GrfSpriteOffset> offsets;
+	GrfSpriteOffset offset{0};
+
+	/* Loop over all sprite section entries and store the file
+	 * offset for each newly encountered ID. */
+	SpriteID id, prev_id = 0;
+	while ((id = file.ReadDword()) != 0) {
+		if (id != prev_id) {
+			offsets[prev_id] = offset;
+			offset.file_pos = file.GetPos() - 4;
+		}
+		prev_id = id;
+		uint length = file.ReadDword();
+		if (length > 0) {
+			SpriteComponents colour{file.ReadByte()};
+			length--;
+			if (length > 0) {
+				uint8_t zoom = file.ReadByte();
+				length--;
+				if (colour.Any() && zoom == 0) { // ZoomLevel::Normal (normal zoom)
+					offset.control_flags.Set((colour != SpriteComponent::Palette) ? SpriteCacheCtrlFlag::AllowZoomMin1x32bpp : SpriteCacheCtrlFlag::AllowZoomMin1xPal);
+					offset.control_flags.Set((colour != SpriteComponent::Palette) ? SpriteCacheCtrlFlag::AllowZoomMin2x32bpp : SpriteCacheCtrlFlag::AllowZoomMin2xPal);
+				}
+				if (colour.Any() && zoom == 2) { // ZoomLevel::In2x (2x zoomed in)
+					offset.control_flags.Set((colour != SpriteComponent::Palette) ? SpriteCacheCtrlFlag::AllowZoomMin2x32bpp : SpriteCacheCtrlFlag::AllowZoomMin2xPal);
+				}
+			}
+		}
+		file.SkipBytes(length);
+	}
+	if (prev_id != 0) offsets[prev_id] = offset;
+
+	return offsets;
+}
+
+/**
+ * Get the sprite offsets of a GRF of which the sprite section is read lazily, reading it if that did not happen yet.
+ * @param file The GRF.
+ * @return Map from sprite numbers to position in the GRF file.
+ */
+static const std::map<uint32_t, GrfSpriteOffset> &GetLazySpriteSectionOffsets(SpriteFile &file)
+{
+	LazySpriteSection &section = _lazy_sprite_sections.at(&file);
+	if (!section.offsets.has_value()) {
+		/* The file might be in the middle of being loaded, so return to where it was. */
+		size_t old_pos = file.GetPos();
+		file.SeekTo(section.begin, SEEK_SET);
+		section.offsets = ReadGRFSpriteSection(file);
+		file.SeekTo(old_pos, SEEK_SET);
+		Debug(sprite, 4, "Read sprite section of '{}' with {} sprites", file.GetFilename(), section.offsets->size());
+	}
+	return *section.offsets;
+}
+
+/**
+ * Replace the sprite section number in a sprite cache entry, loaded with the lazy index, by the position of the sprite in its file.
+ * @param sc The sprite to resolve.
+ */
+static void ResolveLazySpriteOffset(SpriteCache *sc)
+{
+	const auto &offsets = GetLazySpriteSectionOffsets(*sc->file);
+	auto it = offsets.find(static_cast<uint32_t>(sc->file_pos));
+	if (it != offsets.end()) {
+		sc->file_pos = it->second.file_pos;
+		sc->control_flags = it->second.control_flags;
+	} else {
+		sc->file_pos = SIZE_MAX;
+	}
+	sc->lazy_offset = false;
+}
+
 /**
  * Get the file offset for a specific sprite in the sprite section of a GRF.
  * @param id ID of the sprite to look up.
@@ -548,59 +679,109 @@ static std::map<uint32_t, GrfSpriteOffset> _grf_sprite_offsets;
  */
 size_t GetGRFSpriteOffset(uint32_t id)
 {
-	return _grf_sprite_offsets.find(id) != _grf_sprite_offsets.end() ? _grf_sprite_offsets[id].file_pos : SIZE_MAX;
+	const auto &offsets = _lazy_sprite_section_file != nullptr ? GetLazySpriteSectionOffsets(*_lazy_sprite_section_file) : _grf_sprite_offsets;
+	auto it = offsets.find(id);
+	return it != offsets.end() ? it->second.file_pos : SIZE_MAX;
 }
 
 /**
  * Parse the sprite section of GRFs.
- * @param container_version Container version of the GRF we're currently processing.
+ * @param file The GRF we're currently processing.
  */
 void ReadGRFSpriteOffsets(SpriteFile &file)
 {
 	_grf_sprite_offsets.clear();
+	_lazy_sprite_section_file = nullptr;
 
 	if (file.GetContainerVersion() >= 2) {
-		/* Seek to sprite section of the GRF. */
 		size_t data_offset = file.ReadDword();
-		size_t old_pos = file.GetPos();
-		file.SeekTo(data_offset, SEEK_CUR);
 
-		GrfSpriteOffset offset{0};
+		if (_sprite_lazy_index) {
+			/* Only remember where the sprite section is; it is read once a sprite from it is needed. */
+			_lazy_sprite_sections.try_emplace(&file, file.GetPos() + data_offset);
+			_lazy_sprite_section_file = &file;
+			return;
+		}
 
-		/* Loop over all sprite section entries and store the file
-		 * offset for each newly encountered ID. */
-		SpriteID id, prev_id = 0;
-		while ((id = file.ReadDword()) != 0) {
-			if (id != prev_id) {
-				_grf_sprite_offsets[prev_id] = offset;
-				offset.file_pos = file.GetPos() - 4;
-			}
-			prev_id = id;
-			uint length = file.ReadDword();
-			if (length > 0) {
-				SpriteComponents colour{file.ReadByte()};
-				length--;
-				if (length > 0) {
-					uint8_t zoom = file.ReadByte();
-					length--;
-					if (colour.Any() && zoom == 0) { // ZoomLevel::Normal (normal zoom)
-						offset.control_flags.Set((colour != SpriteComponent::Palette) ? SpriteCacheCtrlFlag::AllowZoomMin1x32bpp : SpriteCacheCtrlFlag::AllowZoomMin1xPal);
-						offset.control_flags.Set((colour != SpriteComponent::Palette) ? SpriteCacheCtrlFlag::AllowZoomMin2x32bpp : SpriteCacheCtrlFlag::AllowZoomMin2xPal);
-					}
-					if (colour.Any() && zoom == 2) { // ZoomLevel::In2x (2x zoomed in)
-						offset.control_flags.Set((colour != SpriteComponent::Palette) ? SpriteCacheCtrlFlag::AllowZoomMin2x32bpp : SpriteCacheCtrlFlag::AllowZoomMin2xPal);
-					}
-				}
-			}
-			file.SkipBytes(length);
+		auto it = _grf_sprite_offsets_preloaded.find({file.GetFilename(), file.GetSubdirectory()});
+		if (it != _grf_sprite_offsets_preloaded.end()) {
+			_grf_sprite_offsets = it->second;
+			return;
 		}
-		if (prev_id != 0) _grf_sprite_offsets[prev_id] = offset;
+
+		/* Seek to sprite section of the GRF. */
+		size_t old_pos = file.GetPos();
+		file.SeekTo(data_offset, SEEK_CUR);
+
+		_grf_sprite_offsets = ReadGRFSpriteSection(file);
 
 		/* Continue processing the data section. */
 		file.SeekTo(old_pos, SEEK_SET);
 	}
 }
 
+/**
+ * Read the sprite sections of GRFs, spreading the files over multiple threads.
+ * Every file is read through its own file handle, so the files opened by the sprite cache are not touched.
+ * @param files The file names and sub directories of the GRFs; the files must exist.
+ */
+static void ReadGRFSpriteSections(std::span<const std::pair<std::string, Subdirectory>> files)
+{
+	std::vector<std::optional<std::map<uint32_t, GrfSpriteOffset>>> offsets(files.size());
+	ParallelFor(0, static_cast<int>(files.size()), [&files, &offsets](int i) {
+		SpriteFile file(files[i].first, files[i].second, false);
+		if (file.GetContainerVersion() < 2) return;
+
+		size_t data_offset = file.ReadDword();
+		file.SeekTo(data_offset, SEEK_CUR);
+		offsets[i] = ReadGRFSpriteSection(file);
+	});
+
+	for (size_t i = 0; i < files.size(); i++) {
+		if (offsets[i].has_value()) _grf_sprite_offsets_preloaded[files[i]] = std::move(*offsets[i]);
+	}
+}
+
+/**
+ * Read the sprite sections of GRFs ahead of loading them, spreading the files over multiple threads.
+ * Later calls to #ReadGRFSpriteOffsets for these files use the preloaded offsets.
+ * When the sprite sections are read lazily, they are read in the background while the GRFs are
+ * loaded, and #ClearPreloadedGRFSpriteOffsets hands them to the lazy index once loading is done.
+ * @param files The file names and sub directories of the GRFs; the files must exist.
+ */
+void PreloadGRFSpriteOffsets(std::span<const std::pair<std::string, Subdirectory>> files)
+{
+	ClearPreloadedGRFSpriteOffsets();
+
+	if (_sprite_lazy_index) {
+		std::vector<std::pair<std::string, Subdirectory>> background_files(files.begin(), files.end());
+		if (StartNewThread(&_grf_sprite_offsets_thread, "ottd:grfindex", [background_files = std::move(background_files)]() { ReadGRFSpriteSections(background_files); })) return;
+	}
+
+	ReadGRFSpriteSections(files);
+}
+
+/**
+ * Forget the sprite offsets read by #PreloadGRFSpriteOffsets.
+ * The sprite sections that are read lazily, and were not needed while loading, get the offsets read ahead.
+ */
+void ClearPreloadedGRFSpriteOffsets()
+{
+	if (_grf_sprite_offsets_thread.joinable()) _grf_sprite_offsets_thread.join();
+
+	for (auto &[file, section] : _lazy_sprite_sections) {
+		if (section.offsets.has_value()) continue;
+
+		auto it = _grf_sprite_offsets_preloaded.find({file->GetFilename(), file->GetSubdirectory()});
+		if (it == _grf_sprite_offsets_preloaded.end()) continue;
+
+		section.offsets = std::move(it->second);
+		Debug(sprite, 4, "Read sprite section of '{}' with {} sprites ahead", file->GetFilename(), section.offsets->size());
+	}
+
+	_grf_sprite_offsets_preloaded.clear();
+}
+
 
 /**
  * Load a real or recolour sprite.
@@ -621,6 +802,7 @@ bool LoadNextSprite(SpriteID load_index, SpriteFile &file, uint file_sprite_id)
 
 	SpriteType type;
 	SpriteCacheCtrlFlags control_flags;
+	bool lazy_offset = false;
 	if (grf_type == 0xFF) {
 		/* Some NewGRF files have "empty" pseudo-sprites which are 1
 		 * byte long. Catch these so the sprites won't be displayed. */
@@ -637,9 +819,13 @@ bool LoadNextSprite(SpriteID load_index, SpriteFile &file, uint file_sprite_id)
 			file.SkipBytes(num);
 			return false;
 		}
-		/* It is not an error if no sprite with the provided ID is found in the sprite section. */
-		auto iter = _grf_sprite_offsets.find(file.ReadDword());
-		if (iter != _grf_sprite_offsets.end()) {
+		uint32_t id = file.ReadDword();
+		if (&file == _lazy_sprite_section_file) {
+			/* Keep the number in the sprite section until the sprite is needed; see #ResolveLazySpriteOffset. */
+			file_pos = id;
+			lazy_offset = true;
+		} else if (auto iter = _grf_sprite_offsets.find(id); iter != _grf_sprite_offsets.end()) {
+			/* It is not an error if no sprite with the provided ID is found in the sprite section. */
 			file_pos = iter->second.file_pos;
 			control_flags = iter->second.control_flags;
 		} else {
@@ -670,11 +856,12 @@ bool LoadNextSprite(SpriteID load_index, SpriteFile &file, uint file_sprite_id)
 	sc->file = &file;
 	sc->file_pos = file_pos;
 	sc->length = num;
-	sc->lru = 0;
+	sc->referenced = false;
 	sc->id = file_sprite_id;
 	sc->type = type;
 	sc->warned = false;
 	sc->control_flags = control_flags;
+	sc->lazy_offset = lazy_offset;
 
 	return true;
 }
@@ -692,11 +879,13 @@ void DupSprite(SpriteID old_spr, SpriteID new_spr)
 	scnew->type = scold->type;
 	scnew->warned = false;
 	scnew->control_flags = scold->control_flags;
+	scnew->lazy_offset = scold->lazy_offset;
 }
 
 /**
  * Delete entries from the sprite cache to remove the requested number of bytes.
- * Sprite data is removed in order of LRU values.
+ * The entries are chosen by a clock: the hand goes round all sprites in the cache, gives
+ * sprites that have been used since it last passed them a second chance, and removes the others.
  * The total number of bytes removed may be larger than the number requested.
  * @param to_remove Requested number of bytes to remove.
  */
@@ -704,88 +893,98 @@ static void DeleteEntriesFromSpriteCache(size_t to_remove)
 {
 	const size_t initial_in_use = _spritecache_bytes_used;
 
-	struct SpriteInfo {
-		uint32_t lru;
-		SpriteID id;
-		size_t size;
+	uint deleted = 0;
+	size_t freed = 0;
+	while (freed < to_remove && !_sprite_clock.empty()) {
+		if (_sprite_clock_hand >= _sprite_clock.size()) _sprite_clock_hand = 0;
 
-		bool operator<(const SpriteInfo &other) const
-		{
-			return this->lru < other.lru;
+		SpriteCache *sc = GetSpriteCache(_sprite_clock[_sprite_clock_hand]);
+		if (sc->referenced) {
+			sc->referenced = false;
+			_sprite_clock_hand++;
+			continue;
 		}
-	};
-
-	std::vector<SpriteInfo> candidates; // max heap, ordered by LRU
-	size_t candidate_bytes = 0;         // total bytes that would be released when clearing all sprites in candidates
-
-	auto push = [&](SpriteInfo info) {
-		candidates.push_back(info);
-		std::push_heap(candidates.begin(), candidates.end());
-		candidate_bytes += info.size;
-	};
-
-	auto pop = [&]() {
-		candidate_bytes -= candidates.front().size;
-		std::pop_heap(candidates.begin(), candidates.end());
-		candidates.pop_back();
-	};
 
-	SpriteID i = 0;
-	for (; i != static_cast<SpriteID>(_spritecache.size()) && candidate_bytes < to_remove; i++) {
-		const SpriteCache *sc = GetSpriteCache(i);
-		if (sc->ptr != nullptr) {
-			push({ sc->lru, i, sc->length });
-			if (candidate_bytes >= to_remove) break;
-		}
-	}
-	/* candidates now contains enough bytes to meet to_remove.
-	 * only sprites with LRU values <= the maximum (i.e. the top of the heap) need to be considered */
-	for (; i != static_cast<SpriteID>(_spritecache.size()); i++) {
-		const SpriteCache *sc = GetSpriteCache(i);
-		if (sc->ptr != nullptr && sc->lru <= candidates.front().lru) {
-			push({ sc->lru, i, sc->length });
-			while (!candidates.empty() && candidate_bytes - candidates.front().size >= to_remove) {
-				pop();
-			}
-		}
-	}
-
-	for (const auto &it : candidates) {
-		GetSpriteCache(it.id)->ClearSpriteData();
+		/* This moves another sprite to the position of the hand, so the hand stays put. */
+		freed += sc->length;
+		deleted++;
+		sc->ClearSpriteData();
 	}
+	_sprite_cache_stats.evictions += deleted;
 
 	Debug(sprite, 3, "DeleteEntriesFromSpriteCache, deleted: {}, freed: {}, in use: {} --> {}, requested: {}",
-			candidates.size(), candidate_bytes, initial_in_use, _spritecache_bytes_used, to_remove);
+			deleted, freed, initial_in_use, _spritecache_bytes_used, to_remove);
 }
 
-void IncreaseSpriteLRU()
+/**
+ * Get the number of bytes the sprite cache should stay within.
+ * @return The target size of the sprite cache.
+ */
+static size_t GetSpriteCacheTargetSize()
 {
 	int bpp = BlitterFactory::GetCurrentBlitter()->GetScreenDepth();
-	uint target_size = (bpp > 0 ? _sprite_cache_size * bpp / 8 : 1) * 1024 * 1024;
+	return static_cast<size_t>(bpp > 0 ? _sprite_cache_size * bpp / 8 : 1) * 1024 * 1024;
+}
+
+void IncreaseSpriteLRU()
+{
+	size_t target_size = GetSpriteCacheTargetSize();
 	if (_spritecache_bytes_used > target_size) {
 		DeleteEntriesFromSpriteCache(_spritecache_bytes_used - target_size + 512 * 1024);
 	}
 
-	if (_sprite_lru_counter >= 0xC0000000) {
-		Debug(sprite, 3, "Fixing lru {}, inuse={}", _sprite_lru_counter, _spritecache_bytes_used);
+	/* Do not keep the disk cache files open while no sprites are loaded. */
+	if (_sprite_disk_cache_last_use != std::chrono::steady_clock::time_point{} && std::chrono::steady_clock::now() - _sprite_disk_cache_last_use > SPRITE_DISK_CACHE_IDLE_TIME) {
+		FlushSpriteDiskCaches();
+	}
+}
 
-		for (SpriteCache &sc : _spritecache) {
-			if (sc.ptr != nullptr) {
-				if (sc.lru > 0x80000000) {
-					sc.lru -= 0x80000000;
-				} else {
-					sc.lru = 0;
-				}
-			}
-		}
-		_sprite_lru_counter -= 0x80000000;
+/**
+ * Get the statistics of the sprite cache.
+ * @return The number of hits, misses and evictions since the start, and the current and target size.
+ */
+SpriteCacheStats GetSpriteCacheStats()
+{
+	SpriteCacheStats stats = _sprite_cache_stats;
+	stats.bytes_used = _spritecache_bytes_used;
+	stats.bytes_target = GetSpriteCacheTargetSize();
+	return stats;
+}
+
+/**
+ * Put the data of a sprite in the sprite cache, and let the eviction clock track it.
+ * @param sprite The sprite.
+ * @param sc The sprite cache entry of the sprite.
+ * @param allocator The allocator holding the loaded sprite data.
+ */
+static void StoreSpriteData(SpriteID sprite, SpriteCache *sc, UniquePtrSpriteAllocator &allocator)
+{
+	sc->ptr = std::move(allocator.data);
+	sc->length = static_cast<uint32_t>(allocator.size);
+	_spritecache_bytes_used += sc->length;
+
+	sc->referenced = true;
+	if (sc->clock_index == UINT32_MAX) {
+		sc->clock_index = static_cast<uint32_t>(_sprite_clock.size());
+		_sprite_clock.push_back(sprite);
 	}
 }
 
 void SpriteCache::ClearSpriteData()
 {
+	if (this->ptr == nullptr) return;
+
 	_spritecache_bytes_used -= this->length;
 	this->ptr.reset();
+
+	if (this->clock_index == UINT32_MAX) return;
+
+	/* Fill the hole in the clock with its last sprite. */
+	SpriteID last = _sprite_clock.back();
+	_sprite_clock[this->clock_index] = last;
+	GetSpriteCache(last)->clock_index = this->clock_index;
+	_sprite_clock.pop_back();
+	this->clock_index = UINT32_MAX;
 }
 
 void *UniquePtrSpriteAllocator::AllocatePtr(size_t size)
@@ -795,6 +994,406 @@ void *UniquePtrSpriteAllocator::AllocatePtr(size_t size)
 	return this->data.get();
 }
 
+/** Signature at the start of every sprite disk cache file; the last byte is the version of the format. */
+static const std::array<uint8_t, 8> _sprite_disk_cache_signature = {'O', 'T', 'T', 'D', 'S', 'P', 'C', 2};
+/** Largest encoded sprite that is accepted from a sprite disk cache file; larger sizes mean the file is damaged. */
+static constexpr uint32_t SPRITE_DISK_CACHE_MAX_ENTRY_SIZE = 64 * 1024 * 1024;
+/** Amount of new encoded sprites kept in memory before they are written to the disk cache files. */
+static constexpr size_t SPRITE_DISK_CACHE_MAX_PENDING = 16 * 1024 * 1024;
+/** Extension of sprite disk cache files. */
+static const std::string SPRITE_DISK_CACHE_EXTENSION = ".spc";
+
+/** Location of an encoded sprite in a sprite disk cache file. */
+struct SpriteDiskCacheEntry {
+	long pos; ///< Position of the encoded data in the cache file.
+	uint32_t size; ///< Size of the encoded data.
+	MD5Hash md5sum; ///< Checksum of the encoded data.
+};
+
+/**
+ * Encoded sprites of a single sprite file, stored in a cache file on disk.
+ * The cache file starts with the signature and an identification of the build, the blitter,
+ * the zoom levels and the sprite file it was written for. It is followed by entries of the
+ * position of the sprite in the sprite file, the size and the checksum of the encoded data,
+ * and the encoded data itself, all in native byte order; the file is only meant for the
+ * machine that wrote it.
+ * The cache file is only read while sprites are being loaded. New sprites are collected in
+ * memory and written to a new file, which then replaces the cache file. Other instances of
+ * the game therefore only ever see complete cache files.
+ */
+struct SpriteDiskCache {
+	std::string filename; ///< Name of the cache file, or empty when the sprite file cannot be identified.
+	std::string identity; ///< Identification the cache file has to start with to be usable.
+	std::optional<FileHandle> handle; ///< The cache file while it is open for reading.
+	bool indexed = false; ///< Whether #index describes the cache file.
+	std::map<size_t, SpriteDiskCacheEntry> index; ///< Position of a sprite in the sprite file, to its entry in the cache file.
+	std::map<size_t, std::vector<std::byte>> pending; ///< Position of a sprite in the sprite file, to its encoded data that is not in the cache file yet.
+	std::set<size_t> damaged; ///< Positions of sprites in the sprite file whose entries in the cache file are damaged.
+};
+
+static std::map<const SpriteFile *, SpriteDiskCache> _sprite_disk_caches;
+static size_t _sprite_disk_cache_pending_bytes = 0; ///< Number of bytes of encoded sprites waiting to be written to the disk caches.
+
+/**
+ * Identify the content of a sprite file by its size and modification time, without reading it.
+ * Sprite files within a tar file are identified by the modification time of the tar file and their position in it.
+ * @param file The sprite file.
+ * @return The identification, or \c std::nullopt when the file is not found on disk.
+ */
+static std::optional<std::string> GetSpriteFileIdentity(const SpriteFile &file)
+{
+	std::string path = FioFindFullPath(file.GetSubdirectory(), file.GetFilename());
+	if (path.empty()) {
+		std::string name = file.GetFilename();
+		strtolower(name);
+		auto it = _tar_filelist[file.GetSubdirectory()].find(name);
+		if (it == _tar_filelist[file.GetSubdirectory()].end()) return std::nullopt;
+		path = it->second.tar_filename;
+	}
+
+	std::error_code error_code;
+	auto mtime = std::filesystem::last_write_time(OTTD2FS(path), error_code);
+	if (error_code) return std::nullopt;
+
+	return fmt::format("{}+{}+{}", file.GetStartPos(), file.GetEndPos() - file.GetStartPos(), mtime.time_since_epoch().count());
+}
+
+/**
+ * Get the disk cache with the encoded sprites of a sprite file.
+ * The cache file is specific to the build, the sprite file, the blitter and the zoom levels in use.
+ * Only the name of the cache file is determined; it is opened when a sprite is read from it.
+ * @param file The sprite file.
+ * @return The disk cache, or \c nullptr when it is disabled or can't be used.
+ */
+static SpriteDiskCache *GetSpriteDiskCache(const SpriteFile &file)
+{
+	if (!_sprite_disk_cache) return nullptr;
+
+	Blitter *blitter = BlitterFactory::GetCurrentBlitter();
+	if (blitter == nullptr || blitter->GetScreenDepth() == 0) return nullptr;
+
+	_sprite_disk_cache_last_use = std::chrono::steady_clock::now();
+
+	auto [it, inserted] = _sprite_disk_caches.try_emplace(&file);
+	SpriteDiskCache &cache = it->second;
+	if (!inserted) return cache.filename.empty() ? nullptr : &cache;
+
+	std::optional<std::string> file_identity = GetSpriteFileIdentity(file);
+	if (!file_identity.has_value()) return nullptr;
+
+	std::string settings = fmt::format("{}-{}{}{}{}", blitter->GetName(), static_cast<int>(_settings_client.gui.zoom_min), static_cast<int>(_settings_client.gui.zoom_max),
+			static_cast<int>(_settings_client.gui.sprite_zoom_min), file.NeedsPaletteRemap() ? 1 : 0);
+	cache.identity = fmt::format("{} {} {} {} {}", _openttd_revision, _openttd_build_date, settings, file.GetFilename(), *file_identity);
+
+	/* Different builds and versions of the sprite file get their own cache files, so they do not keep replacing each other's files. */
+	Md5 checksum;
+	checksum.Append(cache.identity.data(), cache.identity.size());
+	MD5Hash md5sum;
+	checksum.Finish(md5sum);
+	cache.filename = fmt::format("{}{}-{}-{}{}", FioFindDirectory(CACHE_DIR), file.GetSimplifiedFilename(), settings, FormatArrayAsHex(std::span(md5sum).first(8)), SPRITE_DISK_CACHE_EXTENSION);
+	return &cache;
+}
+
+/**
+ * Read the header of a sprite disk cache file, and check whether the file is meant for the current situation.
+ * @param f The cache file.
+ * @param identity The identification the file has to start with.
+ * @return True iff the file has the right signature and identification.
+ */
+static bool ReadSpriteDiskCacheHeader(FILE *f, const std::string &identity)
+{
+	std::array<uint8_t, 8> signature;
+	if (fread(signature.data(), 1, signature.size(), f) != signature.size() || signature != _sprite_disk_cache_signature) return false;
+
+	uint32_t length;
+	if (fread(&length, sizeof(length), 1, f) != 1 || length != identity.size()) return false;
+
+	std::string buffer(length, '\0');
+	return fread(buffer.data(), 1, length, f) == length && buffer == identity;
+}
+
+/**
+ * Write the header of a sprite disk cache file.
+ * @param f The cache file.
+ * @param identity The identification of the situation the file is meant for.
+ * @return True iff the header was written.
+ */
+static bool WriteSpriteDiskCacheHeader(FILE *f, const std::string &identity)
+{
+	uint32_t length = static_cast<uint32_t>(identity.size());
+	return fwrite(_sprite_disk_cache_signature.data(), 1, _sprite_disk_cache_signature.size(), f) == _sprite_disk_cache_signature.size() &&
+			fwrite(&length, sizeof(length), 1, f) == 1 && fwrite(identity.data(), 1, length, f) == length;
+}
+
+/**
+ * Read the header of an entry in a sprite disk cache file.
+ * @param f The cache file.
+ * @param[out] file_pos The position of the sprite in the sprite file.
+ * @param[out] size The size of the encoded data.
+ * @param[out] md5sum The checksum of the encoded data.
+ * @return True iff the header was read.
+ */
+static bool ReadSpriteDiskCacheEntryHeader(FILE *f, uint64_t &file_pos, uint32_t &size, MD5Hash &md5sum)
+{
+	return fread(&file_pos, sizeof(file_pos), 1, f) == 1 && fread(&size, sizeof(size), 1, f) == 1 && fread(md5sum.data(), 1, md5sum.size(), f) == md5sum.size();
+}
+
+/**
+ * Write an entry to a sprite disk cache file.
+ * @param f The cache file.
+ * @param file_pos The position of the sprite in the sprite file.
+ * @param data The encoded data.
+ * @param md5sum The checksum of the encoded data.
+ * @return True iff the entry was written.
+ */
+static bool WriteSpriteDiskCacheEntry(FILE *f, uint64_t file_pos, std::span<const std::byte> data, const MD5Hash &md5sum)
+{
+	uint32_t size = static_cast<uint32_t>(data.size());
+	return fwrite(&file_pos, sizeof(file_pos), 1, f) == 1 && fwrite(&size, sizeof(size), 1, f) == 1 && fwrite(md5sum.data(), 1, md5sum.size(), f) == md5sum.size() &&
+			fwrite(data.data(), 1, data.size(), f) == data.size();
+}
+
+/**
+ * Open the file of a sprite disk cache, and index its entries.
+ * A file that was written for another build, blitter, zoom levels or version of the sprite file is not used.
+ * @param cache The disk cache.
+ * @return The open cache file, or \c nullptr when there is no usable cache file.
+ */
+static FILE *OpenSpriteDiskCache(SpriteDiskCache &cache)
+{
+	if (cache.handle.has_value()) return *cache.handle;
+	if (cache.indexed && cache.index.empty()) return nullptr;
+
+	cache.indexed = true;
+	cache.index.clear();
+
+	cache.handle = FileHandle::Open(cache.filename, "rb");
+	if (!cache.handle.has_value()) return nullptr;
+
+	FILE *f = *cache.handle;
+	if (!ReadSpriteDiskCacheHeader(f, cache.identity) || fseek(f, 0, SEEK_END) != 0) {
+		Debug(sprite, 3, "Sprite disk cache {} was written for something else; ignoring it", cache.filename);
+		cache.handle.reset();
+		return nullptr;
+	}
+
+	long length = ftell(f);
+	long pos = static_cast<long>(_sprite_disk_cache_signature.size() + sizeof(uint32_t) + cache.identity.size());
+	fseek(f, pos, SEEK_SET);
+
+	/* Index all complete entries; an incomplete entry at the end is ignored. */
+	uint64_t file_pos;
+	uint32_t size;
+	MD5Hash md5sum;
+	while (ReadSpriteDiskCacheEntryHeader(f, file_pos, size, md5sum)) {
+		long data = ftell(f);
+		if (size > SPRITE_DISK_CACHE_MAX_ENTRY_SIZE || length - data < static_cast<long>(size)) break;
+
+		if (!cache.damaged.contains(file_pos)) cache.index[file_pos] = {data, size, md5sum};
+		if (fseek(f, data + size, SEEK_SET) != 0) break;
+	}
+
+	/* Mark the file as recently used, so pruning the cache directory removes it last. */
+	std::error_code error_code;
+	std::filesystem::last_write_time(OTTD2FS(cache.filename), std::filesystem::file_time_type::clock::now(), error_code);
+
+	Debug(sprite, 3, "Opened sprite disk cache {} with {} sprites", cache.filename, cache.index.size());
+	return f;
+}
+
+/**
+ * Remove the oldest files from the cache directory until the sprite disk cache files fit in their size limit.
+ * Temporary files that were left behind by a crash are removed as well.
+ */
+static void PruneSpriteDiskCacheDirectory()
+{
+	struct CacheFile {
+		std::filesystem::path path;
+		std::filesystem::file_time_type mtime;
+		uintmax_t size;
+	};
+
+	std::error_code error_code;
+	std::vector<CacheFile> files;
+	uintmax_t total = 0;
+	auto now = std::filesystem::file_time_type::clock::now();
+	for (const auto &entry : std::filesystem::directory_iterator(OTTD2FS(FioFindDirectory(CACHE_DIR)), error_code)) {
+		if (!entry.is_regular_file(error_code)) continue;
+
+		std::string name = FS2OTTD(entry.path().filename().native());
+		auto mtime = entry.last_write_time(error_code);
+		if (error_code) continue;
+
+		if (name.ends_with(".tmp") && name.find(SPRITE_DISK_CACHE_EXTENSION + ".") != std::string::npos) {
+			if (now - mtime > std::chrono::hours(1)) std::filesystem::remove(entry.path(), error_code);
+			continue;
+		}
+		if (!name.ends_with(SPRITE_DISK_CACHE_EXTENSION)) continue;
+
+		files.push_back({entry.path(), mtime, entry.file_size(error_code)});
+		total += files.back().size;
+	}
+
+	uintmax_t limit = static_cast<uintmax_t>(_sprite_disk_cache_size) * 1024 * 1024;
+	if (total <= limit) return;
+
+	std::ranges::sort(files, {}, &CacheFile::mtime);
+	for (const CacheFile &file : files) {
+		if (total <= limit) break;
+		if (!std::filesystem::remove(file.path, error_code)) continue;
+
+		Debug(sprite, 3, "Removed sprite disk cache {} to stay within the size limit", FS2OTTD(file.path.native()));
+		total -= file.size;
+	}
+}
+
+/**
+ * Replace the file of a sprite disk cache with one that also contains the new encoded sprites.
+ * The new file is written under a temporary name and then renamed, so another instance of the
+ * game never reads a partially written file. When two instances update the same file at the
+ * same time, the sprites of one of them are simply missing from the result.
+ * @param cache The disk cache.
+ */
+static void WriteSpriteDiskCache(SpriteDiskCache &cache)
+{
+	if (cache.pending.empty()) return;
+
+	/* Take the entries of the current file, which another instance might have replaced in the meantime. */
+	cache.handle.reset();
+	cache.indexed = false;
+	FILE *old_file = OpenSpriteDiskCache(cache);
+
+	std::array<uint8_t, 4> random;
+	RandomBytesWithFallback(random);
+	std::string tmp_filename = fmt::format("{}.{}.tmp", cache.filename, FormatArrayAsHex(random));
+
+	bool success = false;
+	if (auto new_file = FileHandle::Open(tmp_filename, "wb"); new_file.has_value()) {
+		FILE *f = *new_file;
+		success = WriteSpriteDiskCacheHeader(f, cache.identity);
+
+		std::vector<std::byte> buffer;
+		for (const auto &[file_pos, entry] : cache.index) {
+			if (!success) break;
+			if (cache.pending.contains(file_pos)) continue;
+
+			buffer.resize(entry.size);
+			success = fseek(old_file, entry.pos, SEEK_SET) == 0 && fread(buffer.data(), 1, buffer.size(), old_file) == buffer.size() &&
+					WriteSpriteDiskCacheEntry(f, file_pos, buffer, entry.md5sum);
+		}
+		for (const auto &[file_pos, data] : cache.pending) {
+			if (!success) break;
+
+			Md5 checksum;
+			checksum.Append(data.data(), data.size());
+			MD5Hash md5sum;
+			checksum.Finish(md5sum);
+			success = WriteSpriteDiskCacheEntry(f, file_pos, data, md5sum);
+		}
+		success = fflush(f) == 0 && success;
+	}
+
+	cache.handle.reset();
+	cache.indexed = false;
+	cache.index.clear();
+
+	std::error_code error_code;
+	if (success) std::filesystem::rename(OTTD2FS(tmp_filename), OTTD2FS(cache.filename), error_code);
+	if (!success || error_code) {
+		Debug(sprite, 1, "Could not write sprite disk cache {}", cache.filename);
+		std::filesystem::remove(OTTD2FS(tmp_filename), error_code);
+	} else {
+		Debug(sprite, 3, "Wrote {} new sprites to sprite disk cache {}", cache.pending.size(), cache.filename);
+	}
+
+	for (const auto &[file_pos, data] : cache.pending) _sprite_disk_cache_pending_bytes -= data.size();
+	cache.pending.clear();
+}
+
+/**
+ * Write the new encoded sprites of all disk caches to their files, and close the files.
+ * The files are opened again when sprites are loaded from them.
+ */
+void FlushSpriteDiskCaches()
+{
+	bool written = false;
+	for (auto &[file, cache] : _sprite_disk_caches) {
+		written |= !cache.pending.empty();
+		WriteSpriteDiskCache(cache);
+		cache.handle.reset();
+		cache.indexed = false;
+		cache.index.clear();
+	}
+	assert(_sprite_disk_cache_pending_bytes == 0);
+	_sprite_disk_cache_last_use = {};
+
+	if (written) PruneSpriteDiskCacheDirectory();
+}
+
+/**
+ * Load an encoded sprite from the disk cache.
+ * The size and the checksum of the entry are checked before the data is used; when they
+ * do not match, the entry is not used again and the sprite has to be decoded instead.
+ * @param sc The sprite to load.
+ * @param allocator Allocator for the sprite data.
+ * @return True iff the sprite was found in the disk cache.
+ */
+static bool LoadSpriteFromDiskCache(const SpriteCache *sc, SpriteAllocator &allocator)
+{
+	SpriteDiskCache *cache = GetSpriteDiskCache(*sc->file);
+	if (cache == nullptr) return false;
+
+	auto pending = cache->pending.find(sc->file_pos);
+	if (pending != cache->pending.end()) {
+		std::byte *data = allocator.Allocate<std::byte>(pending->second.size());
+		std::copy(pending->second.begin(), pending->second.end(), data);
+		return true;
+	}
+
+	FILE *f = OpenSpriteDiskCache(*cache);
+	if (f == nullptr) return false;
+
+	auto it = cache->index.find(sc->file_pos);
+	if (it == cache->index.end()) return false;
+
+	const SpriteDiskCacheEntry &entry = it->second;
+	std::vector<std::byte> buffer(entry.size);
+	MD5Hash md5sum;
+	if (fseek(f, entry.pos, SEEK_SET) == 0 && fread(buffer.data(), 1, buffer.size(), f) == buffer.size()) {
+		Md5 checksum;
+		checksum.Append(buffer.data(), buffer.size());
+		checksum.Finish(md5sum);
+	}
+	if (md5sum != entry.md5sum) {
+		Debug(sprite, 1, "Damaged entry in sprite disk cache {}; decoding the sprite instead", cache->filename);
+		cache->damaged.insert(sc->file_pos);
+		cache->index.erase(it);
+		return false;
+	}
+
+	std::byte *data = allocator.Allocate<std::byte>(buffer.size());
+	std::copy(buffer.begin(), buffer.end(), data);
+	return true;
+}
+
+/**
+ * Store an encoded sprite in the disk cache, unless it is there already.
+ * The sprite is written to the cache file when the disk caches are flushed.
+ * @param sc The sprite to store.
+ * @param data The encoded sprite.
+ */
+static void StoreSpriteInDiskCache(const SpriteCache *sc, std::span<const std::byte> data)
+{
+	SpriteDiskCache *cache = GetSpriteDiskCache(*sc->file);
+	if (cache == nullptr || cache->index.contains(sc->file_pos) || data.size() > SPRITE_DISK_CACHE_MAX_ENTRY_SIZE) return;
+
+	auto [it, inserted] = cache->pending.try_emplace(sc->file_pos, data.begin(), data.end());
+	if (!inserted) return;
+
+	_sprite_disk_cache_pending_bytes += data.size();
+	if (_sprite_disk_cache_pending_bytes > SPRITE_DISK_CACHE_MAX_PENDING) FlushSpriteDiskCaches();
+}
+
 /**
  * Handles the case when a sprite of different type is requested than is present in the SpriteCache.
  * For SpriteType::Font sprites, it is normal. In other cases, default sprite is loaded instead.
@@ -862,26 +1461,32 @@ void *GetRawSprite(SpriteID sprite, SpriteType type, SpriteAllocator *allocator,
 	}
 
 	SpriteCache *sc = GetSpriteCache(sprite);
+	if (sc->lazy_offset) ResolveLazySpriteOffset(sc);
 
 	if (sc->type != type) return HandleInvalidSpriteRequest(sprite, type, sc, allocator);
 
 	if (allocator == nullptr && encoder == nullptr) {
 		/* Load sprite into/from spritecache */
 
-		/* Update LRU */
-		sc->lru = ++_sprite_lru_counter;
-
 		/* Load the sprite, if it is not loaded, yet */
-		if (sc->ptr == nullptr) {
+		if (sc->ptr != nullptr) {
+			sc->referenced = true;
+			_sprite_cache_stats.hits++;
+		} else {
+			_sprite_cache_stats.misses++;
 			UniquePtrSpriteAllocator cache_allocator;
 			if (sc->type == SpriteType::Recolour) {
 				ReadRecolourSprite(*sc->file, sc->file_pos, sc->length, cache_allocator);
-			} else {
+			} else if (sc->type != SpriteType::Normal) {
 				ReadSprite(sc, sprite, type, cache_allocator, nullptr);
+			} else if (!LoadSpriteFromDiskCache(sc, cache_allocator)) {
+				if (DecodeSprite(sc, *sc->file, sprite, type, cache_allocator, BlitterFactory::GetCurrentBlitter()) != nullptr) {
+					StoreSpriteInDiskCache(sc, {cache_allocator.data.get(), cache_allocator.size});
+				} else {
+					ReadSprite(sc, sprite, type, cache_allocator, nullptr);
+				}
 			}
-			sc->ptr = std::move(cache_allocator.data);
-			sc->length = static_cast<uint32_t>(cache_allocator.size);
-			_spritecache_bytes_used += sc->length;
+			StoreSpriteData(sprite, sc, cache_allocator);
 		}
 
 		return static_cast<void *>(sc->ptr.get());
@@ -891,28 +1496,137 @@ void *GetRawSprite(SpriteID sprite, SpriteType type, SpriteAllocator *allocator,
 	}
 }
 
+/**
+ * Load sprites that are not in the sprite cache yet, decoding them on worker threads.
+ * Each worker reads from its own handles of the sprite files, and the sprite cache itself
+ * is only changed by the calling thread once all workers are done.
+ * Sprites that cannot be decoded this way are left alone; they are loaded when they are drawn.
+ * @param sprites The sprites to load.
+ */
+void PreloadSprites(std::span<const SpriteID> sprites)
+{
+	SpriteEncoder *encoder = BlitterFactory::GetCurrentBlitter();
+	if (encoder == nullptr || !encoder->SupportsConcurrentEncoding()) return;
+
+	/* Do not load more than fits in the sprite cache; the length of a sprite that was cached before is the size of its encoded data. */
+	size_t target_size = GetSpriteCacheTargetSize();
+	size_t expected_size = _spritecache_bytes_used;
+
+	std::vector<SpriteID> todo;
+	for (SpriteID sprite : sprites) {
+		if (!SpriteExists(sprite)) continue;
+
+		SpriteCache *sc = GetSpriteCache(sprite);
+		if (sc->ptr != nullptr || sc->type != SpriteType::Normal || sc->file == nullptr) continue;
+
+		expected_size += sc->length;
+		if (expected_size > target_size) break;
+
+		if (sc->lazy_offset) ResolveLazySpriteOffset(sc);
+		todo.push_back(sprite);
+	}
+	if (todo.empty()) return;
+
+	/* Group the sprites by file, and keep the reads within a file sequential. */
+	std::ranges::sort(todo, [](SpriteID a, SpriteID b) {
+		const SpriteCache *sa = GetSpriteCache(a);
+		const SpriteCache *sb = GetSpriteCache(b);
+		if (sa->file != sb->file) return std::less<const SpriteFile *>{}(sa->file, sb->file);
+		return sa->file_pos < sb->file_pos;
+	});
+
+	std::vector<std::pair<size_t, size_t>> groups;
+	for (size_t first = 0; first != todo.size();) {
+		size_t last = first + 1;
+		while (last != todo.size() && GetSpriteCache(todo[last])->file == GetSpriteCache(todo[first])->file) last++;
+		groups.emplace_back(first, last);
+		first = last;
+	}
+
+	std::vector<UniquePtrSpriteAllocator> results(todo.size());
+	for (size_t i = 0; i != todo.size(); i++) {
+		LoadSpriteFromDiskCache(GetSpriteCache(todo[i]), results[i]);
+	}
+
+	/* Every worker takes its own part of every file, so it opens each file at most once. */
+	const int workers = std::max(1U, std::thread::hardware_concurrency());
+	ParallelFor(0, workers, [&](int worker) {
+		for (const auto &[first, last] : groups) {
+			size_t part = (last - first + workers - 1) / workers;
+			size_t begin = std::min(last, first + part * worker);
+			size_t end = std::min(last, begin + part);
+			while (begin != end && results[begin].data != nullptr) begin++;
+			if (begin == end) continue;
+
+			const SpriteFile &origin = *GetSpriteCache(todo[begin])->file;
+			SpriteFile file(origin.GetFilename(), origin.GetSubdirectory(), origin.NeedsPaletteRemap());
+			for (size_t i = begin; i != end; i++) {
+				if (results[i].data == nullptr) DecodeSprite(GetSpriteCache(todo[i]), file, todo[i], SpriteType::Normal, results[i], encoder);
+			}
+		}
+	});
+
+	uint loaded = 0;
+	for (size_t i = 0; i != todo.size(); i++) {
+		if (results[i].data == nullptr) continue;
+
+		SpriteCache *sc = GetSpriteCache(todo[i]);
+		StoreSpriteInDiskCache(sc, {results[i].data.get(), results[i].size});
+		StoreSpriteData(todo[i], sc, results[i]);
+		loaded++;
+	}
+
+	Debug(sprite, 3, "PreloadSprites, loaded: {} of {}, in use: {}", loaded, todo.size(), _spritecache_bytes_used);
+}
+
 void GfxInitSpriteMem()
 {
 	/* Reset the spritecache 'pool' */
 	_spritecache.clear();
 	_spritecache.shrink_to_fit();
 
+	FlushSpriteDiskCaches();
+	_sprite_disk_caches.clear();
+	_lazy_sprite_sections.clear();
+	_lazy_sprite_section_file = nullptr;
 	_sprite_files.clear();
+	_sprite_clock.clear();
+	_sprite_clock_hand = 0;
 	_spritecache_bytes_used = 0;
 }
 
 /**
  * Remove all encoded sprites from the sprite cache without
  * discarding sprite location information.
+ * @param preload Whether to load the sprites that were cached again straight away, as
+ *                they are likely to be drawn again soon. Only useful when the blitter
+ *                stays the same, as the sprites are encoded by the current blitter.
  */
-void GfxClearSpriteCache()
+void GfxClearSpriteCache(bool preload)
 {
+	std::vector<SpriteID> in_use;
+	std::vector<SpriteID> not_referenced;
+
 	/* Clear sprite ptr for all cached items */
-	for (SpriteCache &sc : _spritecache) {
-		if (sc.ptr != nullptr) sc.ClearSpriteData();
+	for (SpriteID i = 0; i != static_cast<SpriteID>(_spritecache.size()); i++) {
+		SpriteCache *sc = GetSpriteCache(i);
+		if (sc->ptr == nullptr) continue;
+
+		if (sc->type == SpriteType::Normal) (sc->referenced ? in_use : not_referenced).push_back(i);
+		sc->ClearSpriteData();
 	}
 
 	VideoDriver::GetInstance()->ClearSystemSprites();
+
+	/* The blitter or zoom levels might have changed, so other disk caches apply. */
+	FlushSpriteDiskCaches();
+	_sprite_disk_caches.clear();
+
+	if (!preload) return;
+
+	/* Recently drawn sprites first, in case not all of them fit in the sprite cache anymore. */
+	in_use.insert(in_use.end(), not_referenced.begin(), not_referenced.end());
+	PreloadSprites(in_use);
 }
 
 /**
@@ -927,4 +1641,4 @@ void GfxClearFontSpriteCache()
 	}
 }
 
-/* static */ SpriteCollMap<ReusableBuffer<SpriteLoader::CommonPixel>> SpriteLoader::Sprite::buffer;
+/* static */ thread_local SpriteCollMap<ReusableBuffer<SpriteLoader::CommonPixel>> SpriteLoader::Sprite::buffer;
@@ -15,6 +15,9 @@
 #include "spriteloader/spriteloader.hpp"
 
 extern uint _sprite_cache_size;
+extern bool _sprite_disk_cache;
+extern uint _sprite_disk_cache_size;
+extern bool _sprite_lazy_index;
 
 /** SpriteAllocator that allocates memory via a unique_ptr array. */
 class UniquePtrSpriteAllocator : public SpriteAllocator {
@@ -25,6 +28,15 @@ protected:
 	void *AllocatePtr(size_t size) override;
 };
 
+/** Statistics of the sprite cache. */
+struct SpriteCacheStats {
+	uint64_t hits = 0; ///< Number of requests for sprites that were in the cache.
+	uint64_t misses = 0; ///< Number of requests for sprites that had to be loaded.
+	uint64_t evictions = 0; ///< Number of sprites removed from the cache to stay within its size.
+	size_t bytes_used = 0; ///< Number of bytes of sprite data in the cache.
+	size_t bytes_target = 0; ///< Number of bytes the cache should stay within.
+};
+
 void *GetRawSprite(SpriteID sprite, SpriteType type, SpriteAllocator *allocator = nullptr, SpriteEncoder *encoder = nullptr);
 bool SpriteExists(SpriteID sprite);
 
@@ -48,14 +60,19 @@ inline const uint8_t *GetNonSprite(SpriteID sprite, SpriteType type)
 }
 
 void GfxInitSpriteMem();
-void GfxClearSpriteCache();
+void GfxClearSpriteCache(bool preload = false);
 void GfxClearFontSpriteCache();
 void IncreaseSpriteLRU();
+SpriteCacheStats GetSpriteCacheStats();
+void PreloadSprites(std::span<const SpriteID> sprites);
+void FlushSpriteDiskCaches();
 
 SpriteFile &OpenCachedSpriteFile(const std::string &filename, Subdirectory subdir, bool palette_remap);
 std::span<const std::unique_ptr<SpriteFile>> GetCachedSpriteFiles();
 
 void ReadGRFSpriteOffsets(SpriteFile &file);
+void PreloadGRFSpriteOffsets(std::span<const std::pair<std::string, Subdirectory>> files);
+void ClearPreloadedGRFSpriteOffsets();
 size_t GetGRFSpriteOffset(uint32_t id);
 bool LoadNextSprite(SpriteID load_index, SpriteFile &file, uint file_sprite_id);
 bool SkipSpriteData(SpriteFile &file, uint8_t type, uint16_t num);
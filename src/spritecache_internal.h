@@ -25,9 +25,11 @@ struct SpriteCache {
 	SpriteFile *file = nullptr; ///< The file the sprite in this entry can be found in.
 	uint32_t length; ///< Length of sprite data.
 	uint32_t id = 0;
-	uint32_t lru = 0;
+	uint32_t clock_index = UINT32_MAX; ///< Position of this entry in the eviction clock, or UINT32_MAX when it is not in there.
 	SpriteType type = SpriteType::Invalid; ///< In some cases a single sprite is misused by two NewGRFs. Once as real sprite and once as recolour sprite. If the recolour sprite gets into the cache it might be drawn as real sprite which causes enormous trouble.
 	bool warned = false; ///< True iff the user has been warned about incorrect use of this sprite
+	bool referenced = false; ///< True iff the sprite has been used since the eviction clock last passed it
+	bool lazy_offset = false; ///< True iff file_pos is still the number of the sprite in the sprite section of the file
 	SpriteCacheCtrlFlags control_flags{}; ///< Control flags, see SpriteCacheCtrlFlags
 
 	void ClearSpriteData();
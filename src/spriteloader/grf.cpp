@@ -17,6 +17,7 @@
 #include "../core/alloc_type.hpp"
 #include "../core/bitmath_func.hpp"
 #include "../spritecache.h"
+#include "../video/video_driver.hpp"
 #include "grf.hpp"
 
 #include "table/strings.h"
@@ -35,12 +36,15 @@ extern const uint8_t _palmap_w2d[];
  */
 static bool WarnCorruptSprite(const SpriteFile &file, size_t file_pos, int line)
 {
-	static uint8_t warning_level = 0;
-	if (warning_level == 0) {
-		ShowErrorMessage(GetEncodedString(STR_NEWGRF_ERROR_CORRUPT_SPRITE, file.GetSimplifiedFilename()), {}, WL_ERROR);
+	/* Sprites are also decoded on worker threads, so the error message is shown by the main thread. */
+	static std::atomic<uint8_t> warning_level = 0;
+	uint8_t level = warning_level.exchange(6);
+	if (level == 0) {
+		VideoDriver::GetInstance()->QueueOnMainThread([filename = file.GetSimplifiedFilename()]() {
+			ShowErrorMessage(GetEncodedString(STR_NEWGRF_ERROR_CORRUPT_SPRITE, filename), {}, WL_ERROR);
+		});
 	}
-	Debug(sprite, warning_level, "[{}] Loading corrupted sprite from {} at position {}", line, file.GetSimplifiedFilename(), file_pos);
-	warning_level = 6;
+	Debug(sprite, level, "[{}] Loading corrupted sprite from {} at position {}", line, file.GetSimplifiedFilename(), file_pos);
 	return false;
 }
 
@@ -183,9 +187,9 @@ bool DecodeSingleSprite(SpriteLoader::Sprite *sprite, SpriteFile &file, size_t f
 		}
 
 		if (dest_size > sprite_size) {
-			static uint8_t warning_level = 0;
-			Debug(sprite, warning_level, "Ignoring {} unused extra bytes from the sprite from {} at position {}", dest_size - sprite_size, file.GetSimplifiedFilename(), file_pos);
-			warning_level = 6;
+			static std::atomic<uint8_t> warning_level = 0;
+			uint8_t level = warning_level.exchange(6);
+			Debug(sprite, level, "Ignoring {} unused extra bytes from the sprite from {} at position {}", dest_size - sprite_size, file.GetSimplifiedFilename(), file_pos);
 		}
 
 		dest = dest_orig.get();
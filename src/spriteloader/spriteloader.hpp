@@ -75,7 +75,7 @@ public:
 		void AllocateData(ZoomLevel zoom, size_t size) { this->data = Sprite::buffer[zoom].ZeroAllocate(size); }
 	private:
 		/** Allocated memory to pass sprite data around */
-		static SpriteCollMap<ReusableBuffer<SpriteLoader::CommonPixel>> buffer;
+		static thread_local SpriteCollMap<ReusableBuffer<SpriteLoader::CommonPixel>> buffer;
 	};
 
 	/**
@@ -142,6 +142,15 @@ public:
 	 */
 	virtual Sprite *Encode(SpriteType sprite_type, const SpriteLoader::SpriteCollection &sprite, SpriteAllocator &allocator) = 0;
 
+	/**
+	 * Can several sprites be encoded at the same time from different threads?
+	 * @return True iff Encode may be called concurrently.
+	 */
+	virtual bool SupportsConcurrentEncoding()
+	{
+		return true;
+	}
+
 	/**
 	 * Get the value which the height and width on a sprite have to be aligned by.
 	 * @return The needed alignment or 0 if any alignment is accepted.
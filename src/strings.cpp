@@ -459,11 +459,72 @@ std::string GetStringWithArgs(StringID string, StringParameters &args)
 	return result;
 }
 
+/** Key of a formatted string in the cache: the string and the values of its parameters. */
+struct FormattedStringKey {
+	StringID string; ///< The formatted string.
+	std::vector<StringParameterData> params; ///< The values of its parameters.
+
+	bool operator==(const FormattedStringKey &other) const = default;
+};
+
+/** Hash of a #FormattedStringKey. */
+struct FormattedStringKeyHash {
+	size_t operator()(const FormattedStringKey &key) const
+	{
+		size_t hash = std::hash<StringID>{}(key.string);
+		for (const StringParameterData &param : key.params) {
+			hash = hash * 31 + std::hash<StringParameterData>{}(param);
+		}
+		return hash;
+	}
+};
+
+/** Maximum number of formatted strings to cache; when it is full, the cache starts over. */
+static const size_t FORMATTED_STRING_CACHE_SIZE = 4096;
+
+/* The cache belongs to the thread that started it, as other threads may format strings meanwhile. */
+static thread_local std::unordered_map<FormattedStringKey, std::string, FormattedStringKeyHash> _formatted_string_cache; ///< Formatted strings of the current #FormattedStringCacheScope.
+static thread_local uint _formatted_string_cache_scopes = 0; ///< Number of active #FormattedStringCacheScope instances of this thread.
+
+/**
+ * Start caching formatted strings. While the cache is active, the game state,
+ * the language and the settings may not change.
+ */
+FormattedStringCacheScope::FormattedStringCacheScope()
+{
+	_formatted_string_cache_scopes++;
+}
+
+/**
+ * Stop caching formatted strings, and forget the cached ones when this was the outermost scope.
+ */
+FormattedStringCacheScope::~FormattedStringCacheScope()
+{
+	if (--_formatted_string_cache_scopes == 0) _formatted_string_cache.clear();
+}
+
 std::string GetStringWithArgs(StringID string, std::span<StringParameter> args)
 {
+	if (_formatted_string_cache_scopes == 0 || _scan_for_gender_data) {
+		std::string result;
+		StringBuilder builder(result);
+		GetStringWithArgs(builder, string, args);
+		return result;
+	}
+
+	FormattedStringKey key{string, {}};
+	key.params.reserve(args.size());
+	for (const StringParameter &param : args) key.params.push_back(param.data);
+
+	auto it = _formatted_string_cache.find(key);
+	if (it != _formatted_string_cache.end()) return it->second;
+
 	std::string result;
 	StringBuilder builder(result);
 	GetStringWithArgs(builder, string, args);
+
+	if (_formatted_string_cache.size() >= FORMATTED_STRING_CACHE_SIZE) _formatted_string_cache.clear();
+	_formatted_string_cache.emplace(std::move(key), result);
 	return result;
 }
 
@@ -1073,6 +1134,25 @@ static void DecodeEncodedString(StringConsumer &consumer, bool game_script, Stri
 	GetStringWithArgs(builder, stringid, sub_args, true);
 }
 
+/**
+ * Check whether formatting a string might need the types of its parameters up front.
+ * That is only the case for gender lists, which may refer to later parameters, and for
+ * NewGRF control codes, which may inline other strings with gender lists.
+ * @param str The string with format codes.
+ * @return True if the string might contain any of these codes.
+ */
+static bool MayNeedParameterTypes(std::string_view str)
+{
+	/* All control codes are encoded as three bytes starting with 0xEE. Parameters of
+	 * control codes are raw bytes, so this may find codes that are not there, but it
+	 * never misses a code that is there. */
+	for (size_t pos = str.find('\xEE'); pos != std::string_view::npos && pos + 2 < str.size(); pos = str.find('\xEE', pos + 1)) {
+		char32_t c = ((str[pos] & 0x0F) << 12) | ((str[pos + 1] & 0x3F) << 6) | (str[pos + 2] & 0x3F);
+		if (c == SCC_GENDER_LIST || c == SCC_NEWGRF_STRINL || (c >= SCC_NEWGRF_FIRST && c <= SCC_NEWGRF_LAST)) return true;
+	}
+	return false;
+}
+
 /**
  * Parse most format codes within a string and write the result to a buffer.
  * @param builder The string builder to write the final string to.
@@ -1084,14 +1164,14 @@ static void FormatString(StringBuilder &builder, std::string_view str_arg, Strin
 {
 	size_t orig_first_param_offset = args.GetOffset();
 
-	if (!dry_run) {
+	if (!dry_run && MayNeedParameterTypes(str_arg)) {
 		/*
 		 * This function is normally called with `dry_run` false, then we call this function again
 		 * with `dry_run` being true. The dry run is required for the gender formatting. For the
 		 * gender determination we need to format a sub string to get the gender, but for that we
 		 * need to know as what string control code type the specific parameter is encoded. Since
 		 * gendered words can be before the "parameter" words, this needs to be determined before
-		 * the actual formatting.
+		 * the actual formatting. Most strings have no gender lists, so they skip the dry run.
 		 */
 		std::string buffer;
 		StringBuilder dry_run_builder(buffer);
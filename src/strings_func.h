@@ -69,6 +69,18 @@ static inline void PrepareArgsForNextRun(std::span<StringParameter> args)
 }
 
 std::string GetStringWithArgs(StringID string, std::span<StringParameter> args);
+
+/**
+ * While an instance of this class exists, strings formatted by #GetString are cached, so
+ * formatting the same string with the same parameters again returns the cached result.
+ * The game state, language and settings may not change while it exists, for example
+ * while the windows are being drawn.
+ */
+class FormattedStringCacheScope {
+public:
+	FormattedStringCacheScope();
+	~FormattedStringCacheScope();
+};
 std::string GetString(StringID string);
 std::string_view GetStringPtr(StringID string);
 void AppendStringInPlace(std::string &result, StringID string);
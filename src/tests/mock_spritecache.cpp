@@ -29,7 +29,8 @@ static bool MockLoadNextSprite(SpriteID load_index)
 	sc->file_pos = 0;
 	sc->ptr = std::move(allocator.data);
 	sc->length = static_cast<uint32_t>(allocator.size);
-	sc->lru = 0;
+	sc->referenced = false;
+	sc->lazy_offset = false;
 	sc->id = 0;
 	sc->type = is_mapgen ? SpriteType::MapGen : SpriteType::Normal;
 	sc->warned = false;
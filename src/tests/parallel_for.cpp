@@ -0,0 +1,34 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file parallel_for.cpp Test functionality of ParallelFor. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../thread.h"
+
+#include "../safeguards.h"
+
+TEST_CASE("ParallelFor - empty range")
+{
+	int calls = 0;
+	ParallelFor(5, 5, [&calls](int) { calls++; });
+	CHECK(calls == 0);
+	ParallelFor(5, 2, [&calls](int) { calls++; });
+	CHECK(calls == 0);
+}
+
+TEST_CASE("ParallelFor - every index once")
+{
+	std::vector<int> hits(1000);
+	ParallelFor(10, 1000, [&hits](int i) { hits[i]++; });
+
+	for (int i = 0; i < 10; i++) CHECK(hits[i] == 0);
+	for (int i = 10; i < 1000; i++) CHECK(hits[i] == 1);
+}
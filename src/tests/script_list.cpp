@@ -0,0 +1,221 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file script_list.cpp Test functionality of ScriptList. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../script/api/script_list.hpp"
+
+#include "../safeguards.h"
+
+/**
+ * Walk the list in the order of its sorter.
+ * @param list The list to walk.
+ * @return The items in the order they were returned.
+ */
+static std::vector<SQInteger> Walk(ScriptList &list)
+{
+	std::vector<SQInteger> result;
+	for (SQInteger item = list.Begin(); !list.IsEnd(); item = list.Next()) result.push_back(item);
+	return result;
+}
+
+TEST_CASE("ScriptList - items added out of order")
+{
+	ScriptList list;
+	list.AddItem(5, 50);
+	list.AddItem(1, 10);
+	list.AddItem(3, 30);
+	list.AddItem(1, 99);
+
+	CHECK(list.Count() == 3);
+	CHECK(list.HasItem(1));
+	CHECK_FALSE(list.HasItem(2));
+	/* Adding an existing item is ignored. */
+	CHECK(list.GetValue(1) == 10);
+
+	list.Sort(ScriptList::SORT_BY_ITEM, ScriptList::SORT_ASCENDING);
+	CHECK(Walk(list) == std::vector<SQInteger>{1, 3, 5});
+}
+
+TEST_CASE("ScriptList - sorting")
+{
+	ScriptList list;
+	list.AddItem(1, 20);
+	list.AddItem(2, 10);
+	list.AddItem(3, 20);
+	list.AddItem(4, 30);
+
+	/* The default is by value, descending; equal values are walked by descending item. */
+	CHECK(Walk(list) == std::vector<SQInteger>{4, 3, 1, 2});
+
+	list.Sort(ScriptList::SORT_BY_VALUE, ScriptList::SORT_ASCENDING);
+	CHECK(Walk(list) == std::vector<SQInteger>{2, 1, 3, 4});
+
+	list.Sort(ScriptList::SORT_BY_ITEM, ScriptList::SORT_DESCENDING);
+	CHECK(Walk(list) == std::vector<SQInteger>{4, 3, 2, 1});
+
+	list.SetValue(4, 0);
+	list.Sort(ScriptList::SORT_BY_VALUE, ScriptList::SORT_ASCENDING);
+	CHECK(Walk(list) == std::vector<SQInteger>{4, 2, 1, 3});
+}
+
+TEST_CASE("ScriptList - modifying while walking")
+{
+	ScriptList list;
+	list.Sort(ScriptList::SORT_BY_ITEM, ScriptList::SORT_ASCENDING);
+	for (SQInteger i = 0; i < 10; i++) list.AddItem(i, i);
+
+	/* Removing the current item does not affect the walk. */
+	std::vector<SQInteger> seen;
+	for (SQInteger item = list.Begin(); !list.IsEnd(); item = list.Next()) {
+		seen.push_back(item);
+		list.RemoveItem(item);
+	}
+	CHECK(seen.size() == 10);
+	CHECK(list.IsEmpty());
+
+	/* Removing the next item skips it. */
+	for (SQInteger i = 0; i < 10; i++) list.AddItem(i, i);
+	seen.clear();
+	for (SQInteger item = list.Begin(); !list.IsEnd(); item = list.Next()) {
+		seen.push_back(item);
+		list.RemoveItem(item + 1);
+	}
+	CHECK(seen == std::vector<SQInteger>{0, 2, 4, 6, 8});
+
+	/* Moving the current item ahead by changing its value makes it show up again. */
+	list.Clear();
+	list.Sort(ScriptList::SORT_BY_VALUE, ScriptList::SORT_ASCENDING);
+	for (SQInteger i = 0; i < 3; i++) list.AddItem(i, i);
+	seen.clear();
+	for (SQInteger item = list.Begin(); !list.IsEnd(); item = list.Next()) {
+		seen.push_back(item);
+		if (item == 0) list.SetValue(0, 10);
+	}
+	CHECK(seen == std::vector<SQInteger>{0, 1, 2, 0});
+}
+
+TEST_CASE("ScriptList - changing values while walking by value")
+{
+	ScriptList list;
+	list.Sort(ScriptList::SORT_BY_VALUE, ScriptList::SORT_ASCENDING);
+	for (SQInteger i = 0; i < 1000; i++) list.AddItem(i, i);
+
+	/* Lowering the values of walked items, and removing items ahead, does not disturb the walk. */
+	std::vector<SQInteger> seen;
+	for (SQInteger item = list.Begin(); !list.IsEnd(); item = list.Next()) {
+		seen.push_back(item);
+		list.SetValue(item, -item);
+		list.RemoveItem(item + 1);
+	}
+	CHECK(seen.size() == 500);
+	CHECK(list.Count() == 500);
+	CHECK(list.GetValue(998) == -998);
+
+	std::vector<SQInteger> expected;
+	for (SQInteger i = 998; i >= 0; i -= 2) expected.push_back(i);
+	CHECK(Walk(list) == expected);
+}
+
+TEST_CASE("ScriptList - single changes compared to a reference")
+{
+	ScriptList list;
+	std::map<SQInteger, SQInteger> reference;
+	uint32_t seed = 12345;
+	auto next = [&seed](uint32_t range) {
+		seed = seed * 1103515245 + 12345;
+		return static_cast<SQInteger>((seed >> 16) % range);
+	};
+
+	for (int round = 0; round < 50; round++) {
+		for (int i = 0; i < 200; i++) {
+			SQInteger item = next(300);
+			SQInteger value = next(20);
+			switch (next(4)) {
+				case 0: list.AddItem(item, value); reference.try_emplace(item, value); break;
+				case 1: list.RemoveItem(item); reference.erase(item); break;
+				case 2: CHECK(list.SetValue(item, value) == reference.contains(item)); if (reference.contains(item)) reference[item] = value; break;
+				case 3: CHECK(list.HasItem(item) == reference.contains(item)); break;
+			}
+		}
+
+		CHECK(list.Count() == static_cast<SQInteger>(reference.size()));
+
+		std::vector<std::pair<SQInteger, SQInteger>> by_value;
+		for (const auto &[item, value] : reference) by_value.emplace_back(value, item);
+		std::sort(by_value.begin(), by_value.end());
+		std::vector<SQInteger> expected;
+		for (const auto &[value, item] : by_value) expected.push_back(item);
+
+		bool ascending = round % 2 == 0;
+		if (!ascending) std::reverse(expected.begin(), expected.end());
+		list.Sort(ScriptList::SORT_BY_VALUE, ascending);
+		CHECK(Walk(list) == expected);
+
+		expected.clear();
+		for (const auto &[item, value] : reference) expected.push_back(item);
+		if (!ascending) std::reverse(expected.begin(), expected.end());
+		list.Sort(ScriptList::SORT_BY_ITEM, ascending);
+		CHECK(Walk(list) == expected);
+	}
+}
+
+TEST_CASE("ScriptList - bulk removal")
+{
+	ScriptList list;
+	for (SQInteger i = 0; i < 10; i++) list.AddItem(i, i * 10);
+
+	list.KeepBetweenValue(10, 80);
+	CHECK(list.Count() == 6);
+	CHECK_FALSE(list.HasItem(1));
+	CHECK(list.HasItem(7));
+
+	list.RemoveValue(50);
+	CHECK_FALSE(list.HasItem(5));
+
+	/* Top and bottom follow the direction of the sorter. */
+	list.KeepTop(3);
+	CHECK(Walk(list) == std::vector<SQInteger>{7, 6, 4});
+	list.Sort(ScriptList::SORT_BY_ITEM, ScriptList::SORT_ASCENDING);
+	list.RemoveTop(1);
+	CHECK(Walk(list) == std::vector<SQInteger>{6, 7});
+	list.RemoveBottom(5);
+	CHECK(list.IsEmpty());
+}
+
+TEST_CASE("ScriptList - combining lists")
+{
+	ScriptList a;
+	ScriptList b;
+	for (SQInteger i = 0; i < 6; i++) a.AddItem(i, 1);
+	for (SQInteger i = 4; i < 8; i++) b.AddItem(i, 2);
+
+	ScriptList c;
+	c.AddList(&a);
+	c.AddList(&b);
+	CHECK(c.Count() == 8);
+	/* Items in both lists get the value of the added list. */
+	CHECK(c.GetValue(3) == 1);
+	CHECK(c.GetValue(4) == 2);
+
+	c.RemoveList(&b);
+	CHECK(c.Count() == 4);
+	CHECK_FALSE(c.HasItem(5));
+
+	a.KeepList(&b);
+	a.Sort(ScriptList::SORT_BY_ITEM, ScriptList::SORT_ASCENDING);
+	CHECK(Walk(a) == std::vector<SQInteger>{4, 5});
+
+	a.SwapList(&c);
+	CHECK(a.Count() == 4);
+	CHECK(c.Count() == 2);
+	CHECK(Walk(c) == std::vector<SQInteger>{4, 5});
+}
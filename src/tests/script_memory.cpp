@@ -0,0 +1,59 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file script_memory.cpp Test the memory accounting of script VMs. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../script/squirrel.hpp"
+
+#include <squirrel.h>
+
+#include "../safeguards.h"
+
+/**
+ * Run a snippet of Squirrel in the given engine.
+ * @param engine The engine to run the snippet in.
+ * @param squirrel The snippet.
+ */
+static void RunSnippet(Squirrel &engine, std::string_view squirrel)
+{
+	HSQUIRRELVM vm = engine.GetVM();
+	REQUIRE(sq_compilebuffer(vm, squirrel, "test", SQTrue) == SQ_OK);
+	sq_pushroottable(vm);
+	REQUIRE(sq_call(vm, 1, SQFalse, SQTrue) == SQ_OK);
+	sq_pop(vm, 1);
+}
+
+TEST_CASE("Script memory - garbage collection statistics")
+{
+	Squirrel engine{"test"};
+	ScriptAllocatorScope scope{&engine};
+
+	ScriptMemoryStatistics before = engine.GetMemoryStatistics();
+	CHECK(before.allocated > 0);
+	CHECK(before.reserved > 0);
+	CHECK(before.collections == 0);
+
+	/* Create tables that refer to each other, so only the garbage collector can free them. */
+	RunSnippet(engine, "for (local i = 0; i < 1000; i++) { local a = {}; local b = { other = a }; a.other <- b; }");
+	ScriptMemoryStatistics garbage = engine.GetMemoryStatistics();
+	CHECK(garbage.allocated > before.allocated);
+	CHECK(garbage.allocations > before.allocations);
+
+	engine.CollectGarbage();
+	ScriptMemoryStatistics after = engine.GetMemoryStatistics();
+	CHECK(after.collections == 1);
+	CHECK(after.last_collected >= 1000);
+	CHECK(after.allocated < garbage.allocated);
+	/* The chunks that only held freed objects are returned. */
+	CHECK(after.reserved < garbage.reserved);
+	CHECK(after.used < garbage.used);
+	CHECK(after.used <= after.limit);
+}
@@ -0,0 +1,89 @@
+/*
+ * This file is part of OpenTTD.
+ * OpenTTD is free software; you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, version 2.
+ * OpenTTD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details. You should have received a copy of the GNU General Public License along with OpenTTD. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file sortlist_type.cpp Test functionality of GUIList sorting. */
+
+#include "../stdafx.h"
+
+#include "../3rdparty/catch2/catch.hpp"
+
+#include "../sortlist_type.h"
+
+#include "../safeguards.h"
+
+/** Counts the comparisons made while sorting. */
+static int _comparisons;
+
+/** Sort integers ascending, counting the comparisons. */
+static bool IntSorter(const int &a, const int &b)
+{
+	_comparisons++;
+	return a < b;
+}
+
+static std::array<GUIList<int>::SortFunction * const, 1> _int_sorter_funcs = { &IntSorter };
+
+/**
+ * Create a list of the numbers [0, count) in random order.
+ * @param count The number of items.
+ * @return The list.
+ */
+static GUIList<int> MakeList(int count)
+{
+	GUIList<int> list;
+	list.SetSortFuncs(_int_sorter_funcs);
+	for (int i = 0; i < count; i++) list.push_back((i * 7919) % count);
+	list.ForceResort();
+	return list;
+}
+
+TEST_CASE("GUIList - sorting")
+{
+	GUIList<int> list = MakeList(1000);
+	CHECK(list.Sort());
+	CHECK(std::is_sorted(list.begin(), list.end()));
+
+	/* Without a resort request nothing happens. */
+	CHECK_FALSE(list.Sort());
+
+	list.ToggleSortOrder();
+	list.ForceResort();
+	CHECK(list.Sort());
+	CHECK(std::is_sorted(list.rbegin(), list.rend()));
+}
+
+TEST_CASE("GUIList - resorting a few changed items")
+{
+	GUIList<int> list = MakeList(1000);
+	list.Sort();
+
+	/* Move items far forward and backward. */
+	list[10] = 5000;
+	list[990] = -5000;
+	list[500] = 499;
+	list.ForceResort();
+
+	_comparisons = 0;
+	CHECK(list.Sort());
+	CHECK(std::is_sorted(list.begin(), list.end()));
+	CHECK(list.front() == -5000);
+	CHECK(list.back() == 5000);
+	/* Far fewer comparisons than a full sort. */
+	CHECK(_comparisons < 3000);
+}
+
+TEST_CASE("GUIList - resorting many changed items")
+{
+	GUIList<int> list = MakeList(1000);
+	list.Sort();
+
+	for (size_t i = 0; i < list.size(); i += 3) list[i] = -list[i];
+	list.ForceResort();
+
+	CHECK(list.Sort());
+	CHECK(std::is_sorted(list.begin(), list.end()));
+}
@@ -13,6 +13,7 @@
 #include "genworld.h"
 #include "core/random_func.hpp"
 #include "landscape_type.h"
+#include "thread.h"
 
 #include "safeguards.h"
 
@@ -320,6 +321,29 @@ static inline bool IsValidXY(int x, int y)
 }
 
 
+/**
+ * Run a pass of the terrain generation and log how long it took.
+ * @param name Name of the pass for the log.
+ * @param proc The pass to run.
+ */
+template <typename T>
+static void RunTerrainPass(std::string_view name, T &&proc)
+{
+	auto start = std::chrono::steady_clock::now();
+	proc();
+	Debug(map, 2, "TGP: {} took {} ms", name, std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+/**
+ * Call a function for every row of the height map, spread over several threads.
+ * @param proc Function to call with the Y coordinate of each row.
+ */
+template <typename T>
+static void ForAllHeightMapRows(T &&proc)
+{
+	ParallelFor(0, _height_map.size_y + 1, proc);
+}
+
 /**
  * Allocate array of (Map::SizeX() + 1) * (Map::SizeY() + 1) heights and init the _height_map structure members
  */
@@ -389,26 +413,29 @@ static void HeightMapGenerate()
 			continue;
 		}
 
-		/* It is regular iteration round.
+		/* It is regular iteration round. The rows of the interpolation passes
+		 * only depend on rows that are not written, so they can be done in parallel.
 		 * Interpolate height values at odd x, even y tiles */
-		for (int y = 0; y <= _height_map.size_y; y += 2 * step) {
+		ParallelFor(0, _height_map.size_y / (2 * step) + 1, [step](int row) {
+			int y = row * 2 * step;
 			for (int x = 0; x <= _height_map.size_x - 2 * step; x += 2 * step) {
 				Height h00 = _height_map.height(x + 0 * step, y);
 				Height h02 = _height_map.height(x + 2 * step, y);
 				Height h01 = (h00 + h02) / 2;
 				_height_map.height(x + 1 * step, y) = h01;
 			}
-		}
+		});
 
 		/* Interpolate height values at odd y tiles */
-		for (int y = 0; y <= _height_map.size_y - 2 * step; y += 2 * step) {
+		ParallelFor(0, _height_map.size_y / (2 * step), [step](int row) {
+			int y = row * 2 * step;
 			for (int x = 0; x <= _height_map.size_x; x += step) {
 				Height h00 = _height_map.height(x, y + 0 * step);
 				Height h20 = _height_map.height(x, y + 2 * step);
 				Height h10 = (h00 + h20) / 2;
 				_height_map.height(x, y + 1 * step) = h10;
 			}
-		}
+		});
 
 		/* Add noise for next higher frequency (smaller steps) */
 		for (int y = 0; y <= _height_map.size_y; y += step) {
@@ -459,76 +486,79 @@ static int *HeightMapMakeHistogram(Height h_min, [[maybe_unused]] Height h_max,
 /** Applies sine wave redistribution onto height map */
 static void HeightMapSineTransform(Height h_min, Height h_max)
 {
-	for (Height &h : _height_map.h) {
-		double fheight;
-
-		if (h < h_min) continue;
-
-		/* Transform height into 0..1 space */
-		fheight = (double)(h - h_min) / (double)(h_max - h_min);
-		/* Apply sine transform depending on landscape type */
-		switch (_settings_game.game_creation.landscape) {
-			case LandscapeType::Toyland:
-			case LandscapeType::Temperate:
-				/* Move and scale 0..1 into -1..+1 */
-				fheight = 2 * fheight - 1;
-				/* Sine transform */
-				fheight = sin(fheight * M_PI_2);
-				/* Transform it back from -1..1 into 0..1 space */
-				fheight = 0.5 * (fheight + 1);
-				break;
-
-			case LandscapeType::Arctic:
-				{
-					/* Arctic terrain needs special height distribution.
-					 * Redistribute heights to have more tiles at highest (75%..100%) range */
-					double sine_upper_limit = 0.75;
-					double linear_compression = 2;
-					if (fheight >= sine_upper_limit) {
-						/* Over the limit we do linear compression up */
-						fheight = 1.0 - (1.0 - fheight) / linear_compression;
-					} else {
-						double m = 1.0 - (1.0 - sine_upper_limit) / linear_compression;
-						/* Get 0..sine_upper_limit into -1..1 */
-						fheight = 2.0 * fheight / sine_upper_limit - 1.0;
-						/* Sine wave transform */
-						fheight = sin(fheight * M_PI_2);
-						/* Get -1..1 back to 0..(1 - (1 - sine_upper_limit) / linear_compression) == 0.0..m */
-						fheight = 0.5 * (fheight + 1.0) * m;
+	ForAllHeightMapRows([h_min, h_max](int y) {
+		for (int x = 0; x <= _height_map.size_x; x++) {
+			Height &h = _height_map.height(x, y);
+			double fheight;
+
+			if (h < h_min) continue;
+
+			/* Transform height into 0..1 space */
+			fheight = (double)(h - h_min) / (double)(h_max - h_min);
+			/* Apply sine transform depending on landscape type */
+			switch (_settings_game.game_creation.landscape) {
+				case LandscapeType::Toyland:
+				case LandscapeType::Temperate:
+					/* Move and scale 0..1 into -1..+1 */
+					fheight = 2 * fheight - 1;
+					/* Sine transform */
+					fheight = sin(fheight * M_PI_2);
+					/* Transform it back from -1..1 into 0..1 space */
+					fheight = 0.5 * (fheight + 1);
+					break;
+
+				case LandscapeType::Arctic:
+					{
+						/* Arctic terrain needs special height distribution.
+						 * Redistribute heights to have more tiles at highest (75%..100%) range */
+						double sine_upper_limit = 0.75;
+						double linear_compression = 2;
+						if (fheight >= sine_upper_limit) {
+							/* Over the limit we do linear compression up */
+							fheight = 1.0 - (1.0 - fheight) / linear_compression;
+						} else {
+							double m = 1.0 - (1.0 - sine_upper_limit) / linear_compression;
+							/* Get 0..sine_upper_limit into -1..1 */
+							fheight = 2.0 * fheight / sine_upper_limit - 1.0;
+							/* Sine wave transform */
+							fheight = sin(fheight * M_PI_2);
+							/* Get -1..1 back to 0..(1 - (1 - sine_upper_limit) / linear_compression) == 0.0..m */
+							fheight = 0.5 * (fheight + 1.0) * m;
+						}
 					}
-				}
-				break;
-
-			case LandscapeType::Tropic:
-				{
-					/* Desert terrain needs special height distribution.
-					 * Half of tiles should be at lowest (0..25%) heights */
-					double sine_lower_limit = 0.5;
-					double linear_compression = 2;
-					if (fheight <= sine_lower_limit) {
-						/* Under the limit we do linear compression down */
-						fheight = fheight / linear_compression;
-					} else {
-						double m = sine_lower_limit / linear_compression;
-						/* Get sine_lower_limit..1 into -1..1 */
-						fheight = 2.0 * ((fheight - sine_lower_limit) / (1.0 - sine_lower_limit)) - 1.0;
-						/* Sine wave transform */
-						fheight = sin(fheight * M_PI_2);
-						/* Get -1..1 back to (sine_lower_limit / linear_compression)..1.0 */
-						fheight = 0.5 * ((1.0 - m) * fheight + (1.0 + m));
+					break;
+
+				case LandscapeType::Tropic:
+					{
+						/* Desert terrain needs special height distribution.
+						 * Half of tiles should be at lowest (0..25%) heights */
+						double sine_lower_limit = 0.5;
+						double linear_compression = 2;
+						if (fheight <= sine_lower_limit) {
+							/* Under the limit we do linear compression down */
+							fheight = fheight / linear_compression;
+						} else {
+							double m = sine_lower_limit / linear_compression;
+							/* Get sine_lower_limit..1 into -1..1 */
+							fheight = 2.0 * ((fheight - sine_lower_limit) / (1.0 - sine_lower_limit)) - 1.0;
+							/* Sine wave transform */
+							fheight = sin(fheight * M_PI_2);
+							/* Get -1..1 back to (sine_lower_limit / linear_compression)..1.0 */
+							fheight = 0.5 * ((1.0 - m) * fheight + (1.0 + m));
+						}
 					}
-				}
-				break;
+					break;
 
-			default:
-				NOT_REACHED();
-				break;
+				default:
+					NOT_REACHED();
+					break;
+			}
+			/* Transform it back into h_min..h_max space */
+			h = (Height)(fheight * (h_max - h_min) + h_min);
+			if (h < 0) h = I2H(0);
+			if (h >= h_max) h = h_max - 1;
 		}
-		/* Transform it back into h_min..h_max space */
-		h = (Height)(fheight * (h_max - h_min) + h_min);
-		if (h < 0) h = I2H(0);
-		if (h >= h_max) h = h_max - 1;
-	}
+	});
 }
 
 /**
@@ -566,8 +596,6 @@ static void HeightMapCurves(uint level)
 
 	const std::span<const ControlPoint> curve_maps[] = { curve_map_1, curve_map_2, curve_map_3, curve_map_4 };
 
-	std::array<Height, std::size(curve_maps)> ht{};
-
 	/* Set up a grid to choose curve maps based on location; attempt to get a somewhat square grid */
 	float factor = sqrt((float)_height_map.size_x / (float)_height_map.size_y);
 	uint sx = Clamp((int)(((1 << level) * factor) + 0.5), 1, 128);
@@ -578,8 +606,9 @@ static void HeightMapCurves(uint level)
 		c[i] = RandomRange(static_cast<uint32_t>(std::size(curve_maps)));
 	}
 
-	/* Apply curves */
-	for (int x = 0; x < _height_map.size_x; x++) {
+	/* Apply curves; each column only depends on its own heights. */
+	ParallelFor(0, _height_map.size_x, [&](int x) {
+		std::array<Height, std::size(curve_maps)> ht{};
 
 		/* Get our X grid positions and bi-linear ratio */
 		float fx = (float)(sx * x) / _height_map.size_x + 1.0f;
@@ -661,7 +690,7 @@ static void HeightMapCurves(uint level)
 			/* Re-add sea level */
 			*h += I2H(1);
 		}
-	}
+	});
 }
 
 /** Adjusts heights in height map to contain required amount of water tiles */
@@ -693,13 +722,16 @@ static void HeightMapAdjustWaterLevel(int64_t water_percent, Height h_max_new)
 	 *   values from range: h_water_level..h_max are transformed into 0..h_max_new
 	 *   where h_max_new is depending on terrain type and map size.
 	 */
-	for (Height &h : _height_map.h) {
-		/* Transform height from range h_water_level..h_max into 0..h_max_new range */
-		h = (Height)(((int)h_max_new) * (h - h_water_level) / (h_max - h_water_level)) + I2H(1);
-		/* Make sure all values are in the proper range (0..h_max_new) */
-		if (h < 0) h = I2H(0);
-		if (h >= h_max_new) h = h_max_new - 1;
-	}
+	ForAllHeightMapRows([h_water_level, h_max, h_max_new](int y) {
+		for (int x = 0; x <= _height_map.size_x; x++) {
+			Height &h = _height_map.height(x, y);
+			/* Transform height from range h_water_level..h_max into 0..h_max_new range */
+			h = (Height)(((int)h_max_new) * (h - h_water_level) / (h_max - h_water_level)) + I2H(1);
+			/* Make sure all values are in the proper range (0..h_max_new) */
+			if (h < 0) h = I2H(0);
+			if (h >= h_max_new) h = h_max_new - 1;
+		}
+	});
 }
 
 static double perlin_coast_noise_2D(const double x, const double y, const double p, const int prime);
@@ -868,21 +900,21 @@ static void HeightMapNormalize()
 	const Height h_max_new = TGPGetMaxHeight();
 	const Height roughness = 7 + 3 * _settings_game.game_creation.tgen_smoothness;
 
-	HeightMapAdjustWaterLevel(water_percent, h_max_new);
+	RunTerrainPass("water level", [&]() { HeightMapAdjustWaterLevel(water_percent, h_max_new); });
 
 	BorderFlags water_borders = _settings_game.construction.freeform_edges ? _settings_game.game_creation.water_borders : BORDERFLAGS_ALL;
 	if (water_borders == BorderFlag::Random) water_borders = static_cast<BorderFlags>(GB(Random(), 0, 4));
 
-	HeightMapCoastLines(water_borders);
-	HeightMapSmoothSlopes(roughness);
+	RunTerrainPass("coast lines", [&]() { HeightMapCoastLines(water_borders); });
+	RunTerrainPass("slope smoothing", [&]() { HeightMapSmoothSlopes(roughness); });
 
-	HeightMapSmoothCoasts(water_borders);
-	HeightMapSmoothSlopes(roughness);
+	RunTerrainPass("coast smoothing", [&]() { HeightMapSmoothCoasts(water_borders); });
+	RunTerrainPass("slope smoothing", [&]() { HeightMapSmoothSlopes(roughness); });
 
-	HeightMapSineTransform(I2H(1), h_max_new);
+	RunTerrainPass("sine transform", [&]() { HeightMapSineTransform(I2H(1), h_max_new); });
 
 	if (_settings_game.game_creation.variety > 0) {
-		HeightMapCurves(_settings_game.game_creation.variety);
+		RunTerrainPass("curves", []() { HeightMapCurves(_settings_game.game_creation.variety); });
 	}
 }
 
@@ -981,7 +1013,7 @@ void GenerateTerrainPerlin()
 	AllocHeightMap();
 	GenerateWorldSetAbortCallback(FreeHeightMap);
 
-	HeightMapGenerate();
+	RunTerrainPass("noise", HeightMapGenerate);
 
 	IncreaseGeneratingWorldProgress(GWP_LANDSCAPE);
 
@@ -997,12 +1029,14 @@ void GenerateTerrainPerlin()
 
 	int max_height = H2I(TGPGetMaxHeight());
 
-	/* Transfer height map into OTTD map */
-	for (int y = 0; y < _height_map.size_y; y++) {
-		for (int x = 0; x < _height_map.size_x; x++) {
-			TgenSetTileHeight(TileXY(x, y), Clamp(H2I(_height_map.height(x, y)), 0, max_height));
-		}
-	}
+	/* Transfer height map into OTTD map; every tile is only written by its own row. */
+	RunTerrainPass("map transfer", [max_height]() {
+		ParallelFor(0, _height_map.size_y, [max_height](int y) {
+			for (int x = 0; x < _height_map.size_x; x++) {
+				TgenSetTileHeight(TileXY(x, y), Clamp(H2I(_height_map.height(x, y)), 0, max_height));
+			}
+		});
+	});
 
 	FreeHeightMap();
 	GenerateWorldSetAbortCallback(nullptr);
@@ -85,4 +85,44 @@ inline bool StartNewThread(std::thread *thr, std::string_view name, TFn&& _Fx, T
 	return false;
 }
 
+/**
+ * Call a function for every index of a range, splitting the range into
+ * contiguous blocks that are handled by separate threads. The calling thread
+ * handles the last block itself and this function returns once every index
+ * has been handled. If no threads can be started, the whole range is handled
+ * by the calling thread.
+ * @note The function must only write data that belongs to the index it was called with.
+ * @tparam TFn Type of the function to call.
+ * @param begin First index of the range.
+ * @param end One past the last index of the range.
+ * @param fn Function to call with each index.
+ */
+template <class TFn>
+inline void ParallelFor(int begin, int end, TFn &&fn)
+{
+	if (end <= begin) return;
+
+	auto run = [&fn](int first, int last) {
+		for (int i = first; i < last; i++) fn(i);
+	};
+
+	int num_blocks = std::clamp<int>(std::thread::hardware_concurrency(), 1, end - begin);
+	int block_size = (end - begin + num_blocks - 1) / num_blocks;
+
+	std::vector<std::thread> threads;
+	threads.reserve(num_blocks - 1);
+	int first = begin;
+	for (; first + block_size < end; first += block_size) {
+		std::thread &thr = threads.emplace_back();
+		if (!StartNewThread(&thr, "ottd:parallel", [&run, first, block_size]() { run(first, first + block_size); })) {
+			run(first, first + block_size);
+		}
+	}
+	run(first, end);
+
+	for (std::thread &thr : threads) {
+		if (thr.joinable()) thr.join();
+	}
+}
+
 #endif /* THREAD_H */
@@ -246,6 +246,7 @@ TileIndexDiff GetHouseNorthPart(HouseID &house);
 Town *CalcClosestTownFromTile(TileIndex tile, uint threshold = UINT_MAX);
 
 void ResetHouses();
+void ResetTownHouseCandidates();
 
 /** Town actions of a company. */
 enum class TownAction : uint8_t {
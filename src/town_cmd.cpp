@@ -2772,6 +2772,33 @@ static void BuildTownHouse(Town *t, TileIndex tile, const HouseSpec *hs, HouseID
 	if (size.Any(BUILDING_HAS_4_TILES)) TriggerHouseAnimation_ConstructionStageChanged(tile + TileDiffXY(1, 1), true);
 }
 
+/** House types that may appear for a combination of town zone and climate, indexed by the zones. */
+static std::map<uint16_t, std::vector<HouseID>> _town_house_candidates;
+
+/**
+ * Get the house types that may appear on a tile with the given zones. This only
+ * depends on the house specs, so it is calculated once per combination.
+ * @param zones Town zone and climate of the tile.
+ * @return The house types, in house spec order.
+ */
+static const std::vector<HouseID> &GetTownHouseCandidates(HouseZones zones)
+{
+	auto [it, inserted] = _town_house_candidates.try_emplace(zones.base());
+	if (inserted) {
+		for (const auto &hs : HouseSpec::Specs()) {
+			if (!hs.building_availability.All(zones) || !hs.enabled || hs.grf_prop.override_id != INVALID_HOUSE_ID) continue;
+			it->second.push_back(hs.Index());
+		}
+	}
+	return it->second;
+}
+
+/** Forget the cached house candidates, as the house specs are about to change. */
+void ResetTownHouseCandidates()
+{
+	_town_house_candidates.clear();
+}
+
 /**
  * Tries to build a house at this tile.
  * @param t The town the house will belong to.
@@ -2809,22 +2836,21 @@ static bool TryBuildTownHouse(Town *t, TileIndex tile, TownExpandModes modes)
 	uint probability_max = 0;
 
 	/* Generate a list of all possible houses that can be built. */
-	for (const auto &hs : HouseSpec::Specs()) {
-		/* Verify that the candidate house spec matches the current tile status */
-		if (!hs.building_availability.All(zones) || !hs.enabled || hs.grf_prop.override_id != INVALID_HOUSE_ID) continue;
+	for (HouseID house : GetTownHouseCandidates(zones)) {
+		const HouseSpec *hs = HouseSpec::Get(house);
 
 		/* Don't let these counters overflow. Global counters are 32bit, there will never be that many houses. */
-		if (hs.class_id != HOUSE_NO_CLASS) {
+		if (hs->class_id != HOUSE_NO_CLASS) {
 			/* id_count is always <= class_count, so it doesn't need to be checked */
-			if (t->cache.building_counts.class_count[hs.class_id] == UINT16_MAX) continue;
+			if (t->cache.building_counts.class_count[hs->class_id] == UINT16_MAX) continue;
 		} else {
 			/* If the house has no class, check id_count instead */
-			if (t->cache.building_counts.id_count[hs.Index()] == UINT16_MAX) continue;
+			if (t->cache.building_counts.id_count[house] == UINT16_MAX) continue;
 		}
 
-		uint cur_prob = hs.probability;
+		uint cur_prob = hs->probability;
 		probability_max += cur_prob;
-		probs.emplace_back(hs.Index(), cur_prob);
+		probs.emplace_back(house, cur_prob);
 	}
 
 	TileIndex base_tile = tile;
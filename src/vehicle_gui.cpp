@@ -1443,17 +1443,24 @@ static bool VehicleNameSorter(const Vehicle * const &a, const Vehicle * const &b
 {
 	static std::string last_name[2] = { {}, {} };
 
-	if (a != _last_vehicle[0]) {
-		_last_vehicle[0] = a;
-		last_name[0] = GetString(STR_VEHICLE_NAME, a->index);
+	if (a == b) return false;
+
+	/* Sorting compares one vehicle against many others, but not always as the same
+	 * argument. So look for either vehicle in both cached names. */
+	int slot_a = (a == _last_vehicle[0]) ? 0 : (a == _last_vehicle[1]) ? 1 : -1;
+	if (slot_a < 0) {
+		slot_a = (b == _last_vehicle[0]) ? 1 : 0;
+		_last_vehicle[slot_a] = a;
+		last_name[slot_a] = GetString(STR_VEHICLE_NAME, a->index);
 	}
 
-	if (b != _last_vehicle[1]) {
-		_last_vehicle[1] = b;
-		last_name[1] = GetString(STR_VEHICLE_NAME, b->index);
+	int slot_b = 1 - slot_a;
+	if (b != _last_vehicle[slot_b]) {
+		_last_vehicle[slot_b] = b;
+		last_name[slot_b] = GetString(STR_VEHICLE_NAME, b->index);
 	}
 
-	int r = StrNaturalCompare(last_name[0], last_name[1]); // Sort by name (natural sorting).
+	int r = StrNaturalCompare(last_name[slot_a], last_name[slot_b]); // Sort by name (natural sorting).
 	return (r != 0) ? r < 0: VehicleNumberSorter(a, b);
 }
 
@@ -107,6 +107,7 @@ public:
 	/* SpriteEncoder */
 
 	bool Is32BppSupported() override { return true; }
+	bool SupportsConcurrentEncoding() override { return false; }
 	uint GetSpriteAlignment() override { return 1u << to_underlying(ZoomLevel::Max); }
 	Sprite *Encode(SpriteType sprite_type, const SpriteLoader::SpriteCollection &sprite, SpriteAllocator &allocator) override;
 };
@@ -90,6 +90,8 @@
 #include "network/network_func.h"
 #include "framerate_type.h"
 #include "viewport_cmd.h"
+#include "screenshot.h"
+#include "smallmap_gui.h"
 
 #include <forward_list>
 #include <stack>
@@ -2069,6 +2071,8 @@ static bool MarkViewportDirty(const Viewport &vp, int left, int top, int right,
  */
 bool MarkAllViewportsDirty(int left, int top, int right, int bottom)
 {
+	MarkTiledWorldExportDirty(left, top, right, bottom);
+
 	bool dirty = false;
 
 	for (const Window *w : Window::Iterate()) {
@@ -2103,6 +2107,8 @@ void ConstrainAllViewportsZoom()
  */
 void MarkTileDirtyByTile(TileIndex tile, int bridge_level_offset, int tile_height_override)
 {
+	InvalidateSmallMapTile(tile);
+
 	Point pt = RemapCoords(TileX(tile) * TILE_SIZE, TileY(tile) * TILE_SIZE, tile_height_override * TILE_HEIGHT);
 	MarkAllViewportsDirty(
 			pt.x - MAX_TILE_EXTENT_LEFT,
@@ -2505,7 +2511,7 @@ void RebuildViewportOverlay(Window *w)
 	if (w->viewport->overlay != nullptr &&
 			w->viewport->overlay->GetCompanyMask().Any() &&
 			w->viewport->overlay->GetCargoMask() != 0) {
-		w->viewport->overlay->SetDirty();
+		w->viewport->overlay->SetViewDirty();
 		w->SetDirty();
 	}
 }
@@ -22,6 +22,8 @@ enum FramerateWindowWidgets : WidgetID {
 	WID_FRW_TIMES_AVERAGE,
 	WID_FRW_ALLOCSIZE,
 	WID_FRW_SCROLLBAR,
+	WID_FRW_SPRITE_CACHE,
+	WID_FRW_SPRITE_CACHE_RATES,
 };
 
 /** Widgets of the #FrametimeGraphWindow class. */
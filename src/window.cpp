@@ -857,6 +857,178 @@ static bool MayBeShown(const Window *w)
 	}
 }
 
+/** Names of the window classes, indexed by #WindowClass. */
+static const std::string_view _window_class_names[] = {
+	"WC_MAIN_WINDOW",
+	"WC_MAIN_TOOLBAR",
+	"WC_STATUS_BAR",
+	"WC_BUILD_TOOLBAR",
+	"WC_SCEN_BUILD_TOOLBAR",
+	"WC_BUILD_TREES",
+	"WC_TRANSPARENCY_TOOLBAR",
+	"WC_BUILD_SIGNAL",
+	"WC_SMALLMAP",
+	"WC_ERRMSG",
+	"WC_TOOLTIPS",
+	"WC_QUERY_STRING",
+	"WC_CONFIRM_POPUP_QUERY",
+	"WC_GOAL_QUESTION",
+	"WC_SAVELOAD",
+	"WC_LAND_INFO",
+	"WC_DROPDOWN_MENU",
+	"WC_OSK",
+	"WC_SET_DATE",
+	"WC_SCRIPT_SETTINGS",
+	"WC_GRF_PARAMETERS",
+	"WC_TEXTFILE",
+	"WC_TOWN_AUTHORITY",
+	"WC_VEHICLE_DETAILS",
+	"WC_VEHICLE_REFIT",
+	"WC_VEHICLE_ORDERS",
+	"WC_REPLACE_VEHICLE",
+	"WC_VEHICLE_TIMETABLE",
+	"WC_COMPANY_COLOUR",
+	"WC_COMPANY_MANAGER_FACE",
+	"WC_SELECT_STATION",
+	"WC_NEWS_WINDOW",
+	"WC_TOWN_DIRECTORY",
+	"WC_SUBSIDIES_LIST",
+	"WC_INDUSTRY_DIRECTORY",
+	"WC_MESSAGE_HISTORY",
+	"WC_SIGN_LIST",
+	"WC_SCRIPT_LIST",
+	"WC_GOALS_LIST",
+	"WC_STORY_BOOK",
+	"WC_STATION_LIST",
+	"WC_TRAINS_LIST",
+	"WC_ROADVEH_LIST",
+	"WC_SHIPS_LIST",
+	"WC_AIRCRAFT_LIST",
+	"WC_TOWN_VIEW",
+	"WC_VEHICLE_VIEW",
+	"WC_STATION_VIEW",
+	"WC_VEHICLE_DEPOT",
+	"WC_WAYPOINT_VIEW",
+	"WC_INDUSTRY_VIEW",
+	"WC_COMPANY",
+	"WC_BUILD_OBJECT",
+	"WC_BUILD_HOUSE",
+	"WC_BUILD_VEHICLE",
+	"WC_BUILD_BRIDGE",
+	"WC_BUILD_STATION",
+	"WC_BUS_STATION",
+	"WC_TRUCK_STATION",
+	"WC_BUILD_DEPOT",
+	"WC_BUILD_WAYPOINT",
+	"WC_FOUND_TOWN",
+	"WC_BUILD_INDUSTRY",
+	"WC_SELECT_GAME",
+	"WC_SCEN_LAND_GEN",
+	"WC_GENERATE_LANDSCAPE",
+	"WC_MODAL_PROGRESS",
+	"WC_NETWORK_WINDOW",
+	"WC_CLIENT_LIST",
+	"WC_NETWORK_STATUS_WINDOW",
+	"WC_NETWORK_ASK_RELAY",
+	"WC_NETWORK_ASK_SURVEY",
+	"WC_SEND_NETWORK_MSG",
+	"WC_INDUSTRY_CARGOES",
+	"WC_GRAPH_LEGEND",
+	"WC_FINANCES",
+	"WC_INCOME_GRAPH",
+	"WC_OPERATING_PROFIT",
+	"WC_DELIVERED_CARGO",
+	"WC_PERFORMANCE_HISTORY",
+	"WC_COMPANY_VALUE",
+	"WC_COMPANY_LEAGUE",
+	"WC_PAYMENT_RATES",
+	"WC_PERFORMANCE_DETAIL",
+	"WC_INDUSTRY_PRODUCTION",
+	"WC_TOWN_CARGO_GRAPH",
+	"WC_COMPANY_INFRASTRUCTURE",
+	"WC_BUY_COMPANY",
+	"WC_ENGINE_PREVIEW",
+	"WC_MUSIC_WINDOW",
+	"WC_MUSIC_TRACK_SELECTION",
+	"WC_GAME_OPTIONS",
+	"WC_CUSTOM_CURRENCY",
+	"WC_CHEATS",
+	"WC_EXTRA_VIEWPORT",
+	"WC_CONSOLE",
+	"WC_BOOTSTRAP",
+	"WC_HIGHSCORE",
+	"WC_SCRIPT_DEBUG",
+	"WC_NEWGRF_INSPECT",
+	"WC_SPRITE_ALIGNER",
+	"WC_LINKGRAPH_LEGEND",
+	"WC_SAVE_PRESET",
+	"WC_FRAMERATE_DISPLAY",
+	"WC_FRAMETIME_GRAPH",
+	"WC_SCREENSHOT",
+	"WC_HELPWIN",
+};
+static_assert(std::size(_window_class_names) == WC_END);
+
+/**
+ * Get the name of a window class, as it is used in the source.
+ * @param cls The window class.
+ * @return The name of the window class.
+ */
+std::string_view GetWindowClassName(WindowClass cls)
+{
+	if (cls >= WC_END) return "WC_INVALID";
+	return _window_class_names[cls];
+}
+
+static bool _window_redraw_statistics_enabled = false; ///< Whether redraw statistics are collected.
+static WindowRedrawStatisticsArray _window_redraw_statistics; ///< Redraw statistics of each window class since the last reset.
+
+/**
+ * Get the redraw statistics of all window classes since the last reset.
+ * @return The statistics, indexed by window class.
+ */
+const WindowRedrawStatisticsArray &GetWindowRedrawStatistics()
+{
+	return _window_redraw_statistics;
+}
+
+/**
+ * Reset the redraw statistics of all window classes.
+ */
+void ResetWindowRedrawStatistics()
+{
+	_window_redraw_statistics.fill({});
+}
+
+/**
+ * Start or stop collecting redraw statistics.
+ * @param enable Whether to collect the statistics.
+ */
+void EnableWindowRedrawStatistics(bool enable)
+{
+	_window_redraw_statistics_enabled = enable;
+}
+
+/**
+ * Check whether redraw statistics are collected.
+ * @return True iff the statistics are collected.
+ */
+bool AreWindowRedrawStatisticsEnabled()
+{
+	return _window_redraw_statistics_enabled;
+}
+
+/**
+ * Get the redraw statistics to update for a window class.
+ * @param cls The window class.
+ * @return The statistics, or \c nullptr when they are not collected.
+ */
+static WindowRedrawStatistics *GetWindowRedrawStatisticsToUpdate(WindowClass cls)
+{
+	if (!_window_redraw_statistics_enabled || cls >= WC_END) return nullptr;
+	return &_window_redraw_statistics[cls];
+}
+
 /**
  * Generate repaint events for the visible part of window w within the rectangle.
  *
@@ -920,7 +1092,19 @@ static void DrawOverlappedWindow(Window *w, int left, int top, int right, int bo
 	dp->pitch = _screen.pitch;
 	dp->dst_ptr = BlitterFactory::GetCurrentBlitter()->MoveTo(_screen.dst_ptr, left, top);
 	dp->zoom = ZoomLevel::Min;
+
+	WindowRedrawStatistics *stats = GetWindowRedrawStatisticsToUpdate(w->window_class);
+	if (stats == nullptr) {
+		w->OnPaint();
+		return;
+	}
+
+	auto start = std::chrono::steady_clock::now();
 	w->OnPaint();
+
+	stats->paints++;
+	stats->area += static_cast<uint64_t>(right - left) * (bottom - top);
+	stats->time += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
 }
 
 /**
@@ -3110,6 +3294,9 @@ void UpdateWindows()
 	TimerManager<TimerWindow>::Elapsed(delta_ms);
 	CallWindowRealtimeTickEvent(delta_ms.count());
 
+	/* Nothing changes the game state while the windows are updated and drawn. */
+	FormattedStringCacheScope string_cache;
+
 	/* Process invalidations before anything else. */
 	for (Window *w : Window::Iterate()) {
 		w->ProcessScheduledResize();
@@ -3206,8 +3393,15 @@ void Window::InvalidateData(int data, bool gui_scope)
 {
 	this->SetDirty();
 	if (!gui_scope) {
-		/* Schedule GUI-scope invalidation for next redraw. */
-		this->scheduled_invalidation_data.push_back(data);
+		/* Schedule GUI-scope invalidation for next redraw. Game ticks often invalidate
+		 * a window many times with the same data before it is redrawn, so repeating
+		 * the last scheduled invalidation is not scheduled again. */
+		if (!this->scheduled_invalidation_data.empty() && this->scheduled_invalidation_data.back() == data) {
+			WindowRedrawStatistics *stats = GetWindowRedrawStatisticsToUpdate(this->window_class);
+			if (stats != nullptr) stats->coalesced++;
+		} else {
+			this->scheduled_invalidation_data.push_back(data);
+		}
 	}
 	this->OnInvalidateData(data, gui_scope);
 }
@@ -3219,6 +3413,8 @@ void Window::ProcessScheduledInvalidations()
 {
 	for (int data : this->scheduled_invalidation_data) {
 		if (this->window_class == WC_INVALID) break;
+		WindowRedrawStatistics *stats = GetWindowRedrawStatisticsToUpdate(this->window_class);
+		if (stats != nullptr) stats->invalidations++;
 		this->OnInvalidateData(data, true);
 	}
 	this->scheduled_invalidation_data.clear();
@@ -59,6 +59,24 @@ void SetWindowClassesDirty(WindowClass cls);
 void CloseWindowById(WindowClass cls, WindowNumber number, bool force = true, int data = 0);
 void CloseWindowByClass(WindowClass cls, int data = 0);
 
+/** Statistics about repainting the windows of a window class. */
+struct WindowRedrawStatistics {
+	uint64_t paints = 0; ///< Number of times a part of a window was painted.
+	uint64_t area = 0; ///< Number of pixels painted.
+	uint64_t time = 0; ///< Time spent painting, in microseconds.
+	uint64_t invalidations = 0; ///< Number of GUI-scope data invalidations processed.
+	uint64_t coalesced = 0; ///< Number of GUI-scope data invalidations dropped as they repeated the previous one.
+};
+
+/** Redraw statistics of all window classes, indexed by #WindowClass. */
+using WindowRedrawStatisticsArray = std::array<WindowRedrawStatistics, WC_END>;
+
+const WindowRedrawStatisticsArray &GetWindowRedrawStatistics();
+void ResetWindowRedrawStatistics();
+void EnableWindowRedrawStatistics(bool enable);
+bool AreWindowRedrawStatisticsEnabled();
+std::string_view GetWindowClassName(WindowClass cls);
+
 bool EditBoxInGlobalFocus();
 bool FocusedWindowIsConsole();
 Point GetCaretPosition();
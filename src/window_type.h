@@ -729,6 +729,7 @@ enum WindowClass : uint16_t {
 	 */
 	WC_HELPWIN,
 
+	WC_END, ///< End marker of the valid window classes.
 	WC_INVALID = 0xFFFF, ///< Invalid window.
 };
 